@@ -1,6 +1,7 @@
 package vlab.cs.ucsb.edu;
 
 import java.math.BigInteger;
+import java.nio.ByteBuffer;
 import java.util.Map;
 
 /**
@@ -118,6 +119,15 @@ public class DriverProxy {
 
 	public native boolean isSatisfiable(final String constraint);
 
+	/**
+	 * Parses the constraint in place, the bytes between the position and the limit
+	 * of the buffer are read; the position of the buffer is not changed.
+	 * A file mapped with FileChannel.map is parsed without copying it into the heap.
+	 * 
+	 * @param constraint direct byte buffer
+	 */
+	public native boolean isSatisfiable(final ByteBuffer constraint);
+
 	public native BigInteger countVariable(final String varName, final long bound);
 	
 	public native BigInteger countInts(final long bound);
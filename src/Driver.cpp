@@ -10,27 +10,30 @@
 namespace Vlab {
 
 //const Log::Level Driver::TAG = Log::DRIVER;
-bool Driver::IS_LOGGING_INITIALIZED = false;
+std::atomic<bool> Driver::IS_LOGGING_INITIALIZED {false};
 
 Driver::Driver()
     : script_(nullptr),
       symbol_table_(nullptr),
       constraint_information_(nullptr),
-      is_model_counter_cached_ { false } {
+      ast_arena_(new SMT::AstArena()),
+      is_model_counter_cached_ { false },
+      is_solved_from_cache_ { false } {
 }
 
 Driver::~Driver() {
+  std::lock_guard<std::recursive_mutex> automata_lock(Option::Context::automata_mutex());
   delete symbol_table_;
   delete script_;
   delete constraint_information_;
+  ast_arena_->Release();
 }
 
 void Driver::InitializeLogger(int log_level) {
-  if (!IS_LOGGING_INITIALIZED) {
+  if (not IS_LOGGING_INITIALIZED.exchange(true)) {
     FLAGS_v = log_level;
     FLAGS_logtostderr = 1;
     google::InitGoogleLogging("ABC.Java.Driver");
-    IS_LOGGING_INITIALIZED = true;
   }
 }
 
@@ -39,15 +42,62 @@ void Driver::error(const std::string& m) {
 }
 
 int Driver::Parse(std::istream* in) {
+  Option::Context::Scope options_scope(options_);
+  SMT::AstArena::Scope arena_scope(ast_arena_);
+  if (symbol_table_ == nullptr) {
+    symbol_table_ = new Solver::SymbolTable();
+  }
   SMT::Scanner scanner(in);
   //  scanner.set_debug(trace_scanning);
-  SMT::Parser parser(script_, scanner);
+  SMT::Parser parser(script_, scanner, [this](SMT::Command_ptr command) {
+    return HandleCommand(command);
+  });
   //  parser.set_debug_level (trace_parsing);
   int res = parser.parse();
   CHECK_EQ(0, res)<< "Syntax error";
   return res;
 }
 
+int Driver::Parse(const char* data, std::size_t size) {
+  Util::MemoryStreamBuffer buffer(data, size);
+  std::istream in(&buffer);
+  return Parse(&in);
+}
+
+int Driver::ParseFile(const std::string& file_name) {
+  Util::MappedFile file(file_name);
+  CHECK(file.is_open()) << "cannot open input file: " << file_name;
+  return Parse(file.data(), file.size());
+}
+
+/**
+ * Commands are handed over by the parser one at a time and freed as soon as they are consumed,
+ * declarations go into the symbol table right away; only assertions are kept in the script
+ */
+bool Driver::HandleCommand(SMT::Command_ptr command) {
+  if (SMT::Command::Type::ASSERT == command->getType()) {
+    return true;
+  }
+  if (SMT::Command::Type::NONE != command->getType()) {
+    Solver::Initializer initializer(script_, symbol_table_);
+    initializer.visit(command);
+  }
+  delete command;
+  return false;
+}
+
+/**
+ * Drops the commands without any effect on the solver (set-info, set-option, ...) before they
+ * reach the script; used for assertion fragments, which are initialized against the current state
+ */
+bool Driver::KeepCommand(SMT::Command_ptr command) {
+  if (SMT::Command::Type::NONE == command->getType()) {
+    delete command;
+    return false;
+  }
+  return true;
+}
+
 void Driver::ast2dot(std::ostream* out) {
 
   Solver::Ast2Dot ast2dot(out);
@@ -65,8 +115,13 @@ void Driver::ast2dot(std::string file_name) {
 }
 
 void Driver::InitializeSolver() {
+  Option::Context::Scope options_scope(options_);
+  SMT::AstArena::Scope arena_scope(ast_arena_);
+  std::lock_guard<std::recursive_mutex> automata_lock(Option::Context::automata_mutex());
 
-  symbol_table_ = new Solver::SymbolTable();
+  if (symbol_table_ == nullptr) {
+    symbol_table_ = new Solver::SymbolTable();
+  }
   constraint_information_ = new Solver::ConstraintInformation();
 
   Solver::Initializer initializer(script_, symbol_table_);
@@ -83,9 +138,7 @@ void Driver::InitializeSolver() {
 
   if (Option::Solver::ENABLE_EQUIVALENCE_CLASSES) {
     Solver::EquivalenceGenerator equivalence_generator(script_, symbol_table_);
-    do {
-      equivalence_generator.start();
-    } while (equivalence_generator.has_constant_substitution());
+    equivalence_generator.start();
   }
 
   if (Option::Solver::ENABLE_IMPLICATIONS) {
@@ -103,7 +156,35 @@ void Driver::InitializeSolver() {
 }
 
 void Driver::Solve() {
+  Option::Context::Scope options_scope(options_);
+  SMT::AstArena::Scope arena_scope(ast_arena_);
+  std::lock_guard<std::recursive_mutex> automata_lock(Option::Context::automata_mutex());
+
+  if (Option::Solver::CACHE_PATH.empty()) {
+    SolveConstraints();
+    return;
+  }
+
+  Solver::CacheKeyGenerator cache_key_generator(script_, symbol_table_);
+  cache_key_generator.start();
+  Solver::ModelCounterCache cache(Option::Solver::CACHE_PATH);
+  bool is_satisfiable = false;
+  if (cache.Load(cache_key_generator.get_key(), is_satisfiable, model_counter_)) {
+    model_counter_.set_num_threads(Option::Solver::NUM_THREADS);
+    symbol_table_->update_satisfiability_result(is_satisfiable);
+    is_model_counter_cached_ = true;
+    is_solved_from_cache_ = true;
+    return;
+  }
 
+  SolveConstraints();
+  if (symbol_table_->isSatisfiable()) {
+    SetModelCounter();
+  }
+  cache.Store(cache_key_generator.get_key(), symbol_table_->isSatisfiable(), model_counter_);
+}
+
+void Driver::SolveConstraints() {
 //  TODO move arithmetic formula generation and string relation generation here to guide constraint solving better
 //  Solver::ArithmeticFormulaGenerator arithmetic_formula_generator(script_, symbol_table_, constraint_information_);
 //  arithmetic_formula_generator.start();
@@ -113,6 +194,17 @@ void Driver::Solve() {
   // TODO iterate to handle over-approximation, solve the part that contributes to over-approximation
 }
 
+/**
+ * A cached result only has the satisfiability result and the model counter,
+ * variable values are computed the first time they are needed
+ */
+void Driver::SolveCachedConstraints() {
+  if (is_solved_from_cache_) {
+    is_solved_from_cache_ = false;
+    SolveConstraints();
+  }
+}
+
 bool Driver::is_sat() {
   return symbol_table_->isSatisfiable();
 }
@@ -133,6 +225,18 @@ Theory::BigInteger Driver::Count(const unsigned long int_bound, const unsigned l
   return CountInts(int_bound) * CountStrs(str_bound);
 }
 
+std::vector<Theory::BigInteger> Driver::CountVariable(const std::string var_name, const std::vector<unsigned long>& bounds) {
+  return GetModelCounterForVariable(var_name).Count(bounds, bounds);
+}
+
+std::vector<Theory::BigInteger> Driver::CountInts(const std::vector<unsigned long>& bounds) {
+  return GetModelCounter().CountInts(bounds);
+}
+
+std::vector<Theory::BigInteger> Driver::CountStrs(const std::vector<unsigned long>& bounds) {
+  return GetModelCounter().CountStrs(bounds);
+}
+
 Solver::ModelCounter& Driver::GetModelCounterForVariable(const std::string var_name) {
   auto variable = symbol_table_->get_variable(var_name);
   auto representative_variable = symbol_table_->get_representative_variable_of_at_scope(script_, variable);
@@ -152,12 +256,17 @@ Solver::ModelCounter& Driver::GetModelCounter() {
 }
 
 void Driver::SetModelCounterForVariable(const std::string var_name) {
+  Option::Context::Scope options_scope(options_);
+  SMT::AstArena::Scope arena_scope(ast_arena_);
+  std::lock_guard<std::recursive_mutex> automata_lock(Option::Context::automata_mutex());
+  SolveCachedConstraints();
   auto variable = symbol_table_->get_variable(var_name);
   auto representative_variable = symbol_table_->get_representative_variable_of_at_scope(script_, variable);
   auto var_value = symbol_table_->get_projected_value_at_scope(script_, representative_variable);
 
   auto& mc = variable_model_counter_[representative_variable];
   mc.set_use_sign_integers(Option::Solver::USE_SIGNED_INTEGERS);
+  mc.set_num_threads(Option::Solver::NUM_THREADS);
   if (var_value == nullptr) {
     if (SMT::Variable::Type::INT == representative_variable->getType()) {
       mc.set_num_of_unconstraint_int_vars(1);
@@ -189,7 +298,11 @@ void Driver::SetModelCounterForVariable(const std::string var_name) {
    * TODO add string part as well
    */
 void Driver::SetModelCounter() {
+  Option::Context::Scope options_scope(options_);
+  SMT::AstArena::Scope arena_scope(ast_arena_);
+  std::lock_guard<std::recursive_mutex> automata_lock(Option::Context::automata_mutex());
   model_counter_.set_use_sign_integers(Option::Solver::USE_SIGNED_INTEGERS);
+  model_counter_.set_num_threads(Option::Solver::NUM_THREADS);
   int num_bin_var = 0;
   for (const auto &variable_entry : getSatisfyingVariables()) {
     if (variable_entry.second == nullptr) {
@@ -247,6 +360,7 @@ void Driver::inspectResult(Solver::Value_ptr value, std::string file_name) {
 }
 
 void Driver::printResult(Solver::Value_ptr value, std::ostream& out) {
+  std::lock_guard<std::recursive_mutex> automata_lock(Option::Context::automata_mutex());
   switch (value->getType()) {
     case Solver::Value::Type::STRING_AUTOMATON:
       value->getStringAutomaton()->toDotAscii(false, out);
@@ -265,11 +379,19 @@ void Driver::printResult(Solver::Value_ptr value, std::ostream& out) {
   }
 }
 
-std::map<SMT::Variable_ptr, Solver::Value_ptr> Driver::getSatisfyingVariables() const {
+std::map<SMT::Variable_ptr, Solver::Value_ptr> Driver::getSatisfyingVariables() {
+  Option::Context::Scope options_scope(options_);
+  SMT::AstArena::Scope arena_scope(ast_arena_);
+  std::lock_guard<std::recursive_mutex> automata_lock(Option::Context::automata_mutex());
+  SolveCachedConstraints();
   return symbol_table_->get_values_at_scope(script_);
 }
 
 std::map<std::string, std::string> Driver::getSatisfyingExamples() {
+  Option::Context::Scope options_scope(options_);
+  SMT::AstArena::Scope arena_scope(ast_arena_);
+  std::lock_guard<std::recursive_mutex> automata_lock(Option::Context::automata_mutex());
+  SolveCachedConstraints();
   std::map<std::string, std::string> results;
   for (auto& variable_entry : getSatisfyingVariables()) {
     if (Solver::Value::Type::BINARYINT_AUTOMATON == variable_entry.second->getType()) {
@@ -285,14 +407,232 @@ std::map<std::string, std::string> Driver::getSatisfyingExamples() {
 }
 
 void Driver::reset() {
+  std::lock_guard<std::recursive_mutex> automata_lock(Option::Context::automata_mutex());
+  ClearSolverState();
+  for (auto& frame : frames_) {
+    ClearFrameValues(frame);
+  }
+  frames_.clear();
+  assertions_.clear();
+//  LOG(INFO) << "Driver reseted.";
+}
+
+void Driver::Push() {
+  Option::Context::Scope options_scope(options_);
+  SMT::AstArena::Scope arena_scope(ast_arena_);
+  std::lock_guard<std::recursive_mutex> automata_lock(Option::Context::automata_mutex());
+  Frame frame;
+  frame.num_of_assertions = assertions_.size();
+  frame.num_of_commands = 0;
+  frame.num_of_variables = 0;
+  frame.is_satisfiable = true;
+  frame.has_values = (symbol_table_ != nullptr and not is_solved_from_cache_);
+  if (frame.has_values) {
+    frame.num_of_commands = script_->command_list->size();
+    frame.num_of_variables = symbol_table_->get_variables().size();
+    frame.is_satisfiable = symbol_table_->isSatisfiable();
+    for (auto& entry : symbol_table_->get_values_at_scope(script_)) {
+      frame.values[entry.first] = (entry.second == nullptr) ? nullptr : entry.second->clone();
+    }
+  }
+  frames_.push_back(frame);
+}
+
+/**
+ * Restores the values saved by the matching push; all assertions are solved again if the
+ * popped assertions declared variables or the state was rebuilt after the push
+ */
+bool Driver::Pop() {
+  if (frames_.empty()) {
+    LOG(ERROR) << "pop without a matching push";
+    return false;
+  }
+  Option::Context::Scope options_scope(options_);
+  SMT::AstArena::Scope arena_scope(ast_arena_);
+  std::lock_guard<std::recursive_mutex> automata_lock(Option::Context::automata_mutex());
+  Frame frame = frames_.back();
+  frames_.pop_back();
+  assertions_.resize(frame.num_of_assertions);
+
+  if (not frame.has_values or symbol_table_ == nullptr or frame.num_of_variables != symbol_table_->get_variables().size()) {
+    ClearFrameValues(frame);
+    SolveAllAssertions();
+    return true;
+  }
+
+  auto command_list = script_->command_list;
+  for (auto it = command_list->begin() + frame.num_of_commands; it != command_list->end(); ++it) {
+    delete *it;
+  }
+  command_list->resize(frame.num_of_commands);
+
+  auto& values = symbol_table_->get_values_at_scope(script_);
+  for (auto& entry : values) {
+    delete entry.second;
+  }
+  values = frame.values;
+  symbol_table_->set_satisfiability_result(frame.is_satisfiable);
+
+  is_model_counter_cached_ = false;
+  model_counter_ = Solver::ModelCounter();
+  variable_model_counter_.clear();
+  return true;
+}
+
+bool Driver::AddAssertion(const std::string& assertions) {
+  Option::Context::Scope options_scope(options_);
+  SMT::AstArena::Scope arena_scope(ast_arena_);
+  std::lock_guard<std::recursive_mutex> automata_lock(Option::Context::automata_mutex());
+  SMT::Script_ptr fragment = nullptr;
+  std::istringstream in(assertions);
+  SMT::Scanner scanner(&in);
+  SMT::Parser parser(fragment, scanner, KeepCommand);
+  if (parser.parse() != 0) {
+    LOG(ERROR) << "syntax error, assertions are ignored";
+    delete fragment;
+    return false;
+  }
+  assertions_.push_back(assertions);
+
+  if (script_ == nullptr) {
+    delete fragment;
+    SolveAllAssertions();
+    return true;
+  }
+
+  SolveCachedConstraints();
+  is_model_counter_cached_ = false;
+  model_counter_ = Solver::ModelCounter();
+  variable_model_counter_.clear();
+
+  if (not SolveAssertionsIncrementally(fragment)) {
+    SolveAllAssertions();
+  }
+  return true;
+}
+
+/**
+ * Runs the solver passes only on the new commands, in the scope of the current script so that
+ * the new constraints are intersected with the current variable values.
+ * Equivalence classes are not generated for the new commands; arithmetic and multi-track
+ * constraints group variables and cannot be added to existing groups.
+ * @returns false if the new commands need to be solved together with all assertions
+ */
+bool Driver::SolveAssertionsIncrementally(SMT::Script_ptr fragment) {
+  auto command_list = script_->command_list;
+  script_->command_list = fragment->command_list;
+  fragment->command_list = new SMT::CommandList();
+  delete fragment;
+
+  Solver::Initializer initializer(script_, symbol_table_);
+  initializer.start();
+
+  std::set<SMT::Variable_ptr> variables;
+  Solver::AstTraverser variable_collector(script_);
+  variable_collector.setTermPreCallback([this, &variables](SMT::Term_ptr term) -> bool {
+    if (SMT::Term::Type::QUALIDENTIFIER == term->type()) {
+      auto variable = symbol_table_->get_variable_unsafe(dynamic_cast<SMT::QualIdentifier_ptr>(term)->getVarName());
+      if (variable != nullptr) {
+        variables.insert(variable);
+      }
+    }
+    return true;
+  });
+  variable_collector.start();
+  auto is_grouped = [this](SMT::Variable_ptr variable) {
+    return symbol_table_->get_group_variable_of(variable) != variable;
+  };
+
+  bool is_solved = std::none_of(variables.begin(), variables.end(), is_grouped);
+  if (is_solved and symbol_table_->isSatisfiable()) {
+    Solver::ConstraintInformation constraint_information;
+
+    Solver::SyntacticProcessor syntactic_processor(script_);
+    syntactic_processor.start();
+
+    Solver::SyntacticOptimizer syntactic_optimizer(script_, symbol_table_);
+    syntactic_optimizer.start();
+
+    Solver::DependencySlicer dependency_slicer(script_, symbol_table_, &constraint_information);
+    dependency_slicer.start();
+
+    if (Option::Solver::ENABLE_IMPLICATIONS) {
+      Solver::ImplicationRunner implication_runner(script_, symbol_table_);
+      implication_runner.start();
+    }
+
+    Solver::FormulaOptimizer formula_optimizer(script_, symbol_table_);
+    formula_optimizer.start();
+
+    if (Option::Solver::ENABLE_SORTING_HEURISTICS) {
+      Solver::ConstraintSorter constraint_sorter(script_, symbol_table_);
+      constraint_sorter.start();
+    }
+
+    Solver::ConstraintSolver constraint_solver(script_, symbol_table_, &constraint_information);
+    constraint_solver.start();
+
+    is_solved = std::none_of(variables.begin(), variables.end(), is_grouped);
+  }
+
+  command_list->insert(command_list->end(), script_->command_list->begin(), script_->command_list->end());
+  delete script_->command_list;
+  script_->command_list = command_list;
+  return is_solved;
+}
+
+/**
+ * Solves all assertions from scratch, values saved by earlier pushes refer to the
+ * previous symbol table and are dropped
+ */
+void Driver::SolveAllAssertions() {
+  ClearSolverState();
+  for (auto& frame : frames_) {
+    ClearFrameValues(frame);
+  }
+
+  std::string script;
+  for (auto& assertions : assertions_) {
+    script += assertions;
+    script += "\n";
+  }
+  std::istringstream in(script);
+  Parse(&in);
+  InitializeSolver();
+  Solve();
+}
+
+void Driver::ClearFrameValues(Frame& frame) {
+  for (auto& entry : frame.values) {
+    delete entry.second;
+  }
+  frame.values.clear();
+  frame.has_values = false;
+}
+
+void Driver::ClearSolverState() {
   delete symbol_table_;
   delete script_;
+  delete constraint_information_;
   script_ = nullptr;
   symbol_table_ = nullptr;
-//  LOG(INFO) << "Driver reseted.";
+  constraint_information_ = nullptr;
+
+  // blocks of the old arena are returned at once, nodes still referenced elsewhere keep it alive
+  SMT::AstArena_ptr old_arena = ast_arena_;
+  ast_arena_ = new SMT::AstArena();
+  if (SMT::AstArena::Current() == old_arena) {
+    ast_arena_->Install();
+  }
+  old_arena->Release();
+  is_model_counter_cached_ = false;
+  is_solved_from_cache_ = false;
+  model_counter_ = Solver::ModelCounter();
+  variable_model_counter_.clear();
 }
 
 void Driver::set_option(const Option::Name option) {
+  Option::Context::Scope options_scope(options_);
   switch (option) {
     case Option::Name::USE_SIGNED_INTEGERS:
       Option::Solver::USE_SIGNED_INTEGERS = true;
@@ -333,24 +673,38 @@ void Driver::set_option(const Option::Name option) {
     case Option::Name::DISABLE_SORTING_HEURISTICS:
       Option::Solver::ENABLE_SORTING_HEURISTICS = false;
       break;
+    case Option::Name::ENABLE_INTERVAL_DFA:
+      Option::Theory::USE_INTERVAL_DFA = true;
+      break;
+    case Option::Name::DISABLE_INTERVAL_DFA:
+      Option::Theory::USE_INTERVAL_DFA = false;
+      break;
     default:
       LOG(ERROR)<< "option is not recognized: " << static_cast<int>(option);
       break;
     }
-  }
+  options_ = Option::Context::Current();
+}
 
 void Driver::set_option(const Option::Name option, const int value) {
+  Option::Context::Scope options_scope(options_);
   switch (option) {
     case Option::Name::REGEX_FLAG:
       Util::RegularExpression::DEFAULT = value;
       break;
+    case Option::Name::NUM_THREADS:
+      Option::Solver::NUM_THREADS = value;
+      Option::Theory::NUM_THREADS = value;
+      break;
     default:
       LOG(ERROR)<< "option is not recognized: " << static_cast<int>(option) << " -> " << value;
       break;
     }
+  options_ = Option::Context::Current();
 }
 
 void Driver::set_option(const Option::Name option, const std::string value) {
+  Option::Context::Scope options_scope(options_);
   switch (option) {
     case Option::Name::OUTPUT_PATH:
       Option::Solver::OUTPUT_PATH = value;
@@ -360,10 +714,14 @@ void Driver::set_option(const Option::Name option, const std::string value) {
       Option::Solver::SCRIPT_PATH = value;
       Option::Theory::SCRIPT_PATH = value;
       break;
+    case Option::Name::CACHE_PATH:
+      Option::Solver::CACHE_PATH = value;
+      break;
     default:
       LOG(ERROR)<< "option is not recognized: " << static_cast<int>(option) << " -> " << value;
       break;
     }
+  options_ = Option::Context::Current();
 }
 
 void Driver::test() {
@@ -8,14 +8,17 @@
 #ifndef SRC_DRIVER_H_
 #define SRC_DRIVER_H_
 
+#include <atomic>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <limits>
 #include <map>
 #include <sstream>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <glog/logging.h>
 
@@ -25,9 +28,11 @@
 #include "parser/location.hh"
 #include "parser/parser.hpp"
 #include "parser/Scanner.h"
+#include "smt/AstArena.h"
 #include "smt/ast.h"
 #include "smt/typedefs.h"
 #include "solver/Ast2Dot.h"
+#include "solver/CacheKeyGenerator.h"
 #include "solver/ConstraintInformation.h"
 #include "solver/ConstraintSolver.h"
 #include "solver/ConstraintSorter.h"
@@ -37,6 +42,8 @@
 #include "solver/ImplicationRunner.h"
 #include "solver/Initializer.h"
 #include "solver/ModelCounter.h"
+#include "solver/ModelCounterCache.h"
+#include "solver/options/Context.h"
 #include "solver/options/Solver.h"
 #include "solver/SymbolTable.h"
 #include "solver/SyntacticOptimizer.h"
@@ -50,6 +57,7 @@
 #include "theory/StringAutomaton.h"
 #include "theory/StringRelation.h"
 #include "theory/SymbolicCounter.h"
+#include "utils/MemoryBuffer.h"
 #include "utils/Serialize.h"
 
 namespace Vlab {
@@ -69,7 +77,19 @@ public:
   // Error handling.
   void error(const Vlab::SMT::location& l, const std::string& m);
   void error(const std::string& m);
+  /**
+   * Commands are consumed as they are parsed, declarations are added to the symbol table and
+   * freed; the script keeps only the assertions
+   */
   int Parse(std::istream* in = &std::cin);
+  /**
+   * Parses the input in place, without copying it into a stream
+   */
+  int Parse(const char* data, std::size_t size);
+  /**
+   * Parses a memory-mapped file in place, the input is not copied into a stream first
+   */
+  int ParseFile(const std::string& file_name);
   void ast2dot(std::string file_name);
   void ast2dot(std::ostream* out);
 //	void collectStatistics();
@@ -81,15 +101,29 @@ public:
   Theory::BigInteger CountInts(const unsigned long bound);
   Theory::BigInteger CountStrs(const unsigned long bound);
   Theory::BigInteger Count(const unsigned long int_bound, const unsigned long str_bound);
+  std::vector<Theory::BigInteger> CountVariable(const std::string var_name, const std::vector<unsigned long>& bounds);
+  std::vector<Theory::BigInteger> CountInts(const std::vector<unsigned long>& bounds);
+  std::vector<Theory::BigInteger> CountStrs(const std::vector<unsigned long>& bounds);
 
   Solver::ModelCounter& GetModelCounterForVariable(const std::string var_name);
   Solver::ModelCounter& GetModelCounter();
 
   void printResult(Solver::Value_ptr value, std::ostream& out);
   void inspectResult(Solver::Value_ptr value, std::string file_name);
-  std::map<SMT::Variable_ptr, Solver::Value_ptr> getSatisfyingVariables() const;
+  std::map<SMT::Variable_ptr, Solver::Value_ptr> getSatisfyingVariables();
   std::map<std::string, std::string> getSatisfyingExamples();
   void reset();
+
+  /**
+   * Incremental solving, assertions added after a push are removed by the matching pop.
+   * New assertions are solved against the current variable values when they only
+   * involve single-track constraints, otherwise all assertions are solved again.
+   * AddAssertion returns false and keeps the current state if the assertions do not parse,
+   * Pop returns false and changes nothing if there is no matching push.
+   */
+  void Push();
+  bool Pop();
+  bool AddAssertion(const std::string& assertions);
 //	void solveAst();
 
   void set_option(const Option::Name option);
@@ -107,18 +141,55 @@ public:
   std::string file_;
 
 protected:
+  /**
+   * Solver state saved by Push
+   */
+  struct Frame {
+    std::size_t num_of_assertions;
+    std::size_t num_of_commands;
+    std::size_t num_of_variables;
+    bool is_satisfiable;
+    bool has_values;
+    Solver::VariableValueMap values;
+  };
+
+  bool HandleCommand(SMT::Command_ptr command);
+  static bool KeepCommand(SMT::Command_ptr command);
+  void ClearSolverState();
+  void ClearFrameValues(Frame& frame);
+  bool SolveAssertionsIncrementally(SMT::Script_ptr fragment);
+  void SolveAllAssertions();
+  void SolveConstraints();
+  void SolveCachedConstraints();
   void SetModelCounterForVariable(const std::string var_name);
   void SetModelCounter();
 
+  /**
+   * Options of this driver, installed on the calling thread by each entry point
+   */
+  Option::Context options_;
+  /**
+   * Owns the memory of the script nodes, installed together with the options
+   */
+  SMT::AstArena_ptr ast_arena_;
   bool is_model_counter_cached_;
+  /**
+   * Result is loaded from the on-disk cache, variable values are computed on demand
+   */
+  bool is_solved_from_cache_;
   Solver::ModelCounter model_counter_;
   /**
    * Keeps projected model counters for a variable
    */
   std::map<SMT::Variable_ptr, Solver::ModelCounter> variable_model_counter_;
+  /**
+   * Sources of the assertions added incrementally and the frames saved by push
+   */
+  std::vector<std::string> assertions_;
+  std::vector<Frame> frames_;
 
 private:
-  static bool IS_LOGGING_INITIALIZED;
+  static std::atomic<bool> IS_LOGGING_INITIALIZED;
 
 };
 
@@ -28,6 +28,7 @@
 #include "solver/Value.h"
 #include "theory/BinaryIntAutomaton.h"
 #include "theory/MultiTrackAutomaton.h"
+#include "theory/StringAutomatonCache.h"
 #include "theory/StringRelation.h"
 #include "utils/RegularExpression.h"
 
@@ -35,6 +36,12 @@
 //static const std::string get_default_log_dir();
 
 std::vector<unsigned long> parse_count_bounds(std::string);
+void solve_query(Vlab::Driver& driver, std::istream* in, const std::string& file_name,
+                 const std::vector<unsigned long>& int_bounds, const std::vector<unsigned long>& str_bounds,
+                 const std::string& count_variable, const std::string& output_root);
+void report_result(Vlab::Driver& driver, const std::chrono::steady_clock::duration solving_time,
+                   const std::vector<unsigned long>& int_bounds, const std::vector<unsigned long>& str_bounds,
+                   const std::string& count_variable);
 
 int main(const int argc, const char **argv) {
 
@@ -56,6 +63,7 @@ int main(const int argc, const char **argv) {
   driver.set_option(Vlab::Option::Name::REGEX_FLAG, 0x000e);
 
   bool experiment_mode = false;
+  bool server_mode = false;
   std::vector<unsigned long> str_bounds;
   std::vector<unsigned long> int_bounds;
   std::string count_variable {""};
@@ -63,8 +71,6 @@ int main(const int argc, const char **argv) {
   for (int i = 1; i < argc; ++i) {
     if (argv[i] == std::string("-i") or argv[i] == std::string("--input-file")) {
       file_name = argv[i + 1];
-      file = new std::ifstream(file_name);
-      in = file;
       ++i;
     } else if (argv[i] == std::string("--use-unsinged")) {
       driver.set_option(Vlab::Option::Name::USE_UNSIGNED_INTEGERS);
@@ -92,6 +98,10 @@ int main(const int argc, const char **argv) {
       driver.set_option(Vlab::Option::Name::ENABLE_SORTING_HEURISTICS);
     } else if (argv[i] == std::string("--disable-sorting")) {
       driver.set_option(Vlab::Option::Name::DISABLE_SORTING_HEURISTICS);
+    } else if (argv[i] == std::string("--enable-interval-dfa")) {
+      driver.set_option(Vlab::Option::Name::ENABLE_INTERVAL_DFA);
+    } else if (argv[i] == std::string("--disable-interval-dfa")) {
+      driver.set_option(Vlab::Option::Name::DISABLE_INTERVAL_DFA);
     } else if (argv[i] == std::string("-bs") or argv[i] == std::string("--bound-str")) {
       std::string bounds_str {argv[i + 1]};
       str_bounds = parse_count_bounds(bounds_str);
@@ -108,6 +118,15 @@ int main(const int argc, const char **argv) {
     } else if (argv[i] == std::string("--count-variable")) {
       count_variable = argv[i + 1];
       ++i;
+    } else if (argv[i] == std::string("--threads")) {
+      driver.set_option(Vlab::Option::Name::NUM_THREADS, std::stoi(argv[i + 1]));
+      ++i;
+    } else if (argv[i] == std::string("--cache-dir")) {
+      driver.set_option(Vlab::Option::Name::CACHE_PATH, std::string(argv[i + 1]));
+      ++i;
+    } else if (argv[i] == std::string("--automaton-cache-size")) {
+      Vlab::Theory::StringAutomatonCache::Instance().set_capacity(std::stoul(argv[i + 1]));
+      ++i;
     } else if (argv[i] == std::string("--output-dir")) {
       output_root = argv[i + 1];
       ++i;
@@ -120,6 +139,8 @@ int main(const int argc, const char **argv) {
       ++i;
     } else if (argv[i] == std::string("-e")) {
       experiment_mode = true;
+    } else if (argv[i] == std::string("--server")) {
+      server_mode = true;
     } else if (argv[i] == std::string("-h") or argv[i] == std::string("--help")) {
       int col = 28;
       std::cout << std::left;
@@ -142,6 +163,12 @@ int main(const int argc, const char **argv) {
       std::cout << std::setw(col) << "--limit-len-implications" << ": disables length implications for word equations" << std::endl;
       std::cout << std::setw(col) << "--enable-sorting" << ": enables sorting heuristics for string constraints" << std::endl;
       std::cout << std::setw(col) << "--disable-sorting" << ": disables sorting heuristics for string constraints" << std::endl;
+      std::cout << std::setw(col) << "--enable-interval-dfa" << ": intersects, unites and concatenates string automata on byte intervals instead of bdds" << std::endl;
+      std::cout << std::setw(col) << "--disable-interval-dfa" << ": uses bdd based string automata operations (default)" << std::endl;
+      std::cout << std::setw(col) << "--server" << ": solves a stream of queries separated by (reset) lines without restarting, (push)/(pop) lines solve incrementally" << std::endl;
+      std::cout << std::setw(col) << "--threads <value>" << ": number of threads used to count independent components and to build counting matrices of large automata" << std::endl;
+      std::cout << std::setw(col) << "--cache-dir <dir>" << ": reuses solving and counting results stored in the directory" << std::endl;
+      std::cout << std::setw(col) << "--automaton-cache-size <n>" << ": number of regex and string constant automata kept in memory, 0 disables the cache" << std::endl;
       std::cout << std::setw(col) << "--output-dir <dir>" << ": used for debugging outputs" << std::endl;
       std::cout << std::setw(col) << "--log-dir <dir>" << ": redirect logs from stderr to files and saves in the directory specified." << std::endl;
       std::cout << std::setw(col) << "--v <value>" << ": sets verbose logging level, unless you build ABC with configure --disable-debug" << std::endl;
@@ -164,12 +191,126 @@ int main(const int argc, const char **argv) {
 //  }
   /* log test end */
 
+  // a single query is parsed from the mapped file, the server reads its queries line by line
+  if (server_mode and not file_name.empty()) {
+    file = new std::ifstream(file_name);
+    in = file;
+  }
+
   if (not in->good()) {
-    LOG(FATAL) << "Cannot find input: ";
+    LOG(FATAL) << "Cannot find input: " << file_name;
   }
 
   driver.test();
-  driver.Parse(in);
+  if (server_mode) {
+    /*
+     * Queries are separated by (reset) lines, the driver is reused for each one.
+     * Within a query, (push)/(pop) lines and (check-sat) lines solve incrementally.
+     */
+    std::string line;
+    std::stringstream assertions;
+    bool has_assertions = false;
+    bool is_reported = true;
+    bool has_script = false;
+    bool has_syntax_error = false;
+    unsigned long query_id = 0;
+    auto add_assertions = [&]() -> std::chrono::steady_clock::duration {
+      auto start = std::chrono::steady_clock::now();
+      if (has_assertions or not has_script) {
+        if (driver.AddAssertion(assertions.str())) {
+          is_reported = not has_assertions;
+          has_script = true;
+        } else {
+          // previous state is kept, the error is reported in place of the next result
+          has_syntax_error = true;
+          is_reported = false;
+        }
+      }
+      assertions.str("");
+      assertions.clear();
+      has_assertions = false;
+      return std::chrono::steady_clock::now() - start;
+    };
+    auto report = [&](std::chrono::steady_clock::duration solving_time) {
+      LOG(INFO) << "report query: " << query_id++;
+      if (has_syntax_error) {
+        LOG(INFO) << "report error: syntax error, assertions are ignored";
+        has_syntax_error = false;
+      } else {
+        report_result(driver, solving_time, int_bounds, str_bounds, count_variable);
+      }
+      is_reported = true;
+    };
+    while (std::getline(*in, line)) {
+      auto first = line.find_first_not_of(" \t\r");
+      auto last = line.find_last_not_of(" \t\r");
+      std::string command = (first == std::string::npos) ? "" : line.substr(first, last - first + 1);
+      if (command == "(reset)") {
+        auto solving_time = add_assertions();
+        if (not is_reported) {
+          report(solving_time);
+        }
+        driver.reset();
+        has_script = false;
+        is_reported = true;
+      } else if (command == "(check-sat)") {
+        report(add_assertions());
+      } else if (command.compare(0, 5, "(push") == 0 or command.compare(0, 4, "(pop") == 0) {
+        add_assertions();
+        bool is_push = command.compare(0, 5, "(push") == 0;
+        std::string levels = command.substr(is_push ? 5 : 4, command.size() - (is_push ? 6 : 5));
+        auto level_first = levels.find_first_not_of(" \t");
+        auto level_last = levels.find_last_not_of(" \t");
+        std::string level = (level_first == std::string::npos) ? "1" : levels.substr(level_first, level_last - level_first + 1);
+        if (command.back() != ')' or level.empty() or level.size() > 9
+            or level.find_first_not_of("0123456789") != std::string::npos) {
+          LOG(INFO) << "report error: invalid level in " << command << ", command is ignored";
+          continue;
+        }
+        int n = std::stoi(level);
+        for (int i = 0; i < n; ++i) {
+          if (is_push) {
+            driver.Push();
+          } else if (not driver.Pop()) {
+            LOG(INFO) << "report error: pop without a matching push, " << n - i << " level(s) are ignored";
+            break;
+          }
+        }
+      } else {
+        assertions << line << "\n";
+        has_assertions = has_assertions or first != std::string::npos;
+      }
+    }
+    auto solving_time = add_assertions();
+    if (not is_reported) {
+      report(solving_time);
+    }
+  } else {
+    solve_query(driver, in, file_name, int_bounds, str_bounds, count_variable, output_root);
+  }
+
+  auto& automaton_cache = Vlab::Theory::StringAutomatonCache::Instance();
+  LOG(INFO) << "automaton cache hits: " << automaton_cache.num_of_hits() << " misses: " << automaton_cache.num_of_misses();
+  LOG(INFO) << "done.";
+
+  if (file != nullptr) {
+    delete file;
+  }
+
+  return 0;
+}
+
+/**
+ * Parses, solves and reports the result of a single query
+ */
+void solve_query(Vlab::Driver& driver, std::istream* in, const std::string& file_name,
+                 const std::vector<unsigned long>& int_bounds, const std::vector<unsigned long>& str_bounds,
+                 const std::string& count_variable, const std::string& output_root) {
+  if (file_name.empty()) {
+    driver.Parse(in);
+  } else {
+    driver.ParseFile(file_name);
+  }
 
 #ifndef NDEBUG
   if (VLOG_IS_ON(30)) {
@@ -191,6 +332,16 @@ int main(const int argc, const char **argv) {
   auto solving_time = end - start;
   LOG(INFO) << "Done solving";
 
+  report_result(driver, solving_time, int_bounds, str_bounds, count_variable);
+}
+
+/**
+ * Reports satisfiability and model counts of the last solved query
+ */
+void report_result(Vlab::Driver& driver, const std::chrono::steady_clock::duration solving_time,
+                   const std::vector<unsigned long>& int_bounds, const std::vector<unsigned long>& str_bounds,
+                   const std::string& count_variable) {
+  std::chrono::steady_clock::time_point start, end;
   if (driver.is_sat()) {
     if (VLOG_IS_ON(30)) {
        //      unsigned index = 0;
@@ -273,43 +424,26 @@ int main(const int argc, const char **argv) {
     LOG(INFO)<< "report is_sat: SAT time: " << std::chrono::duration <long double, std::milli> (solving_time).count() << " ms";
     if(not count_variable.empty()) {
       LOG(INFO) << "report var: " << count_variable;
+      auto total_count_time = std::chrono::steady_clock::duration::zero();
       for (auto b : int_bounds) {
         start = std::chrono::steady_clock::now();
         auto count_result = driver.CountVariable(count_variable, b);
         end = std::chrono::steady_clock::now();
         auto count_time = end - start;
+        total_count_time += count_time;
         LOG(INFO) << "report bound: " << b << " count: " << count_result << " time: "
                   << std::chrono::duration<long double, std::milli>(count_time).count() << " ms";
-
-//        auto mc = driver.GetModelCounterForVariable(count_variable);
-//
-//        std::cout << std::endl << mc << std::endl;
-//        mc.Count(b, b);
-//         std::stringstream os;
-//         {
-//           cereal::BinaryOutputArchive ar(os);
-//           mc.save(ar);
-//         }
-//
-//         std::string test = os.str();
-//         std::stringstream is(test);
-//
-//         Vlab::Solver::ModelCounter mcc;
-//
-//         {
-//          cereal::BinaryInputArchive ar2(is);
-//          mcc.load(ar2);
-//        }
-//
-//        std::cout << std::endl << mcc << std::endl;
-//        mcc.Count(b, b);
       }
+      LOG(INFO) << "report count time: " << std::chrono::duration<long double, std::milli>(total_count_time).count() << " ms";
     } else {
+      // bounds are counted one by one to keep the per bound time, counters continue from the last bound
+      auto total_count_time = std::chrono::steady_clock::duration::zero();
       for (auto b : int_bounds) {
         start = std::chrono::steady_clock::now();
         auto count = driver.CountInts(b);
         end = std::chrono::steady_clock::now();
         auto count_time = end - start;
+        total_count_time += count_time;
         LOG(INFO) << "report bound: " << b << " count: " << count << " time: "
                   << std::chrono::duration<long double, std::milli>(count_time).count() << " ms";
       }
@@ -318,22 +452,19 @@ int main(const int argc, const char **argv) {
         auto count = driver.CountStrs(b);
         end = std::chrono::steady_clock::now();
         auto count_time = end - start;
+        total_count_time += count_time;
         LOG(INFO) << "report bound: " << b << " count: " << count << " time: "
                   << std::chrono::duration<long double, std::milli>(count_time).count() << " ms";
       }
+      if (not (int_bounds.empty() and str_bounds.empty())) {
+        LOG(INFO) << "report count time: " << std::chrono::duration<long double, std::milli>(total_count_time).count() << " ms";
+      }
     }
   } else {
     LOG(INFO) << "report is_sat: UNSAT time: " << std::chrono::duration <long double, std::milli> (solving_time).count() << " ms";
     LOG(INFO) << "report count: 0 time: 0";
   }
 
-  LOG(INFO) << "done.";
-
-  if (file != nullptr) {
-    delete file;
-  }
-
-  return 0;
 }
 
 std::vector<unsigned long> parse_count_bounds(std::string bounds_str) {
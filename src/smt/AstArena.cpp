@@ -0,0 +1,133 @@
+/*
+ * AstArena.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "AstArena.h"
+
+#include <new>
+
+namespace Vlab {
+namespace SMT {
+
+const std::size_t AstArena::SIZE_CLASS_GRANULARITY = sizeof(AstArena::Header);
+const std::size_t AstArena::NUM_OF_SIZE_CLASSES = 32;
+const std::size_t AstArena::BLOCK_SIZE = 64 * 1024;
+
+thread_local AstArena_ptr AstArena::current_ = nullptr;
+
+AstArena::AstArena()
+    : is_released_(false),
+      num_of_live_nodes_(0),
+      next_(nullptr),
+      end_(nullptr),
+      free_lists_(NUM_OF_SIZE_CLASSES, nullptr) {
+}
+
+AstArena::~AstArena() {
+  for (auto block : blocks_) {
+    ::operator delete(block);
+  }
+}
+
+void AstArena::Release() {
+  is_released_ = true;
+  if (num_of_live_nodes_ == 0) {
+    delete this;
+  }
+}
+
+void AstArena::Install() {
+  current_ = this;
+}
+
+std::size_t AstArena::num_of_live_nodes() const {
+  return num_of_live_nodes_;
+}
+
+std::size_t AstArena::num_of_blocks() const {
+  return blocks_.size();
+}
+
+/**
+ * Sizes are rounded up to the granularity, nodes larger than the biggest size class and nodes
+ * allocated without an arena use the global heap
+ */
+void* AstArena::Allocate(std::size_t size) {
+  const std::size_t size_class = (size + sizeof(Header) + SIZE_CLASS_GRANULARITY - 1) / SIZE_CLASS_GRANULARITY;
+  Header* header = nullptr;
+  if (current_ != nullptr and size_class < NUM_OF_SIZE_CLASSES) {
+    header = static_cast<Header*>(current_->allocate_from_pool(size_class));
+    header->arena = current_;
+  } else {
+    header = static_cast<Header*>(::operator new(size_class * SIZE_CLASS_GRANULARITY));
+    header->arena = nullptr;
+  }
+  header->size_class = size_class;
+  return header + 1;
+}
+
+void AstArena::Deallocate(void* pointer) {
+  if (pointer == nullptr) {
+    return;
+  }
+  Header* header = static_cast<Header*>(pointer) - 1;
+  if (header->arena == nullptr) {
+    ::operator delete(header);
+    return;
+  }
+  AstArena_ptr arena = header->arena;
+  arena->deallocate_to_pool(header, header->size_class);
+  if (arena->is_released_ and arena->num_of_live_nodes_ == 0) {
+    delete arena;
+  }
+}
+
+AstArena_ptr AstArena::Current() {
+  return current_;
+}
+
+void* AstArena::allocate_from_pool(std::size_t size_class) {
+  ++num_of_live_nodes_;
+  FreeNode* free_node = free_lists_[size_class];
+  if (free_node != nullptr) {
+    free_lists_[size_class] = free_node->next;
+    return free_node;
+  }
+
+  const std::size_t size = size_class * SIZE_CLASS_GRANULARITY;
+  if (next_ == nullptr or static_cast<std::size_t>(end_ - next_) < size) {
+    // remainder of the current block is not reused, it is at most the biggest size class
+    char* block = static_cast<char*>(::operator new(BLOCK_SIZE));
+    blocks_.push_back(block);
+    next_ = block;
+    end_ = block + BLOCK_SIZE;
+  }
+  void* pointer = next_;
+  next_ += size;
+  return pointer;
+}
+
+void AstArena::deallocate_to_pool(void* pointer, std::size_t size_class) {
+  --num_of_live_nodes_;
+  FreeNode* free_node = static_cast<FreeNode*>(pointer);
+  free_node->next = free_lists_[size_class];
+  free_lists_[size_class] = free_node;
+}
+
+AstArena::Scope::Scope(AstArena_ptr arena)
+    : previous_(AstArena::current_) {
+  AstArena::current_ = arena;
+}
+
+AstArena::Scope::~Scope() {
+  AstArena::current_ = previous_;
+}
+
+} /* namespace SMT */
+} /* namespace Vlab */
@@ -0,0 +1,106 @@
+/*
+ * AstArena.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SRC_SMT_ASTARENA_H_
+#define SRC_SMT_ASTARENA_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace Vlab {
+namespace SMT {
+
+class AstArena;
+using AstArena_ptr = AstArena*;
+
+/**
+ * Pools the memory of the AST nodes of a script. Nodes are bump allocated from large blocks
+ * and recycled through per size free lists, so the many small nodes created and deleted by the
+ * optimizers do not fragment the heap; the blocks are returned at once when the owner releases
+ * the arena and the last node allocated from it is deleted.
+ * The arena does not own the nodes: they are still cloned and deleted one by one, and deleting
+ * a script still runs the recursive destructors (term lists and strings live on the heap).
+ * Nodes allocated while an arena is installed on the calling thread (see Scope) come from that
+ * arena, other nodes come from the global heap. An arena is used by one thread at a time.
+ */
+class AstArena {
+ public:
+  AstArena();
+  AstArena(const AstArena&) = delete;
+  AstArena& operator=(const AstArena&) = delete;
+
+  /**
+   * Drops the owner's reference, arena is deleted once its nodes are deleted
+   */
+  void Release();
+
+  /**
+   * Installs the arena on the calling thread, see Scope
+   */
+  void Install();
+
+  std::size_t num_of_live_nodes() const;
+  std::size_t num_of_blocks() const;
+
+  static void* Allocate(std::size_t size);
+  static void Deallocate(void* pointer);
+
+  /**
+   * @returns arena installed on the calling thread or nullptr
+   */
+  static AstArena_ptr Current();
+
+  class Scope;
+
+ protected:
+  ~AstArena();
+  void* allocate_from_pool(std::size_t size_class);
+  void deallocate_to_pool(void* pointer, std::size_t size_class);
+
+  struct FreeNode {
+    FreeNode* next;
+  };
+
+  /**
+   * precedes every node, keeps nodes aligned to the size class granularity
+   */
+  struct alignas(16) Header {
+    AstArena_ptr arena;
+    std::size_t size_class;
+  };
+
+  static const std::size_t SIZE_CLASS_GRANULARITY;
+  static const std::size_t NUM_OF_SIZE_CLASSES;
+  static const std::size_t BLOCK_SIZE;
+
+  bool is_released_;
+  std::size_t num_of_live_nodes_;
+  char* next_;
+  char* end_;
+  std::vector<char*> blocks_;
+  std::vector<FreeNode*> free_lists_;
+  static thread_local AstArena_ptr current_;
+};
+
+/**
+ * Installs an arena on the calling thread for the lifetime of the scope and restores the previous one afterwards
+ */
+class AstArena::Scope {
+ public:
+  Scope(AstArena_ptr arena);
+  ~Scope();
+ private:
+  AstArena_ptr previous_;
+};
+
+} /* namespace SMT */
+} /* namespace Vlab */
+
+#endif /* SRC_SMT_ASTARENA_H_ */
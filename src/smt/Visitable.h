@@ -8,8 +8,10 @@
 #ifndef SMT_VISITABLE_H_
 #define SMT_VISITABLE_H_
 
+#include <cstddef>
 #include <vector>
 
+#include "AstArena.h"
 #include "typedefs.h"
 
 namespace Vlab {
@@ -20,6 +22,17 @@ public:
   virtual ~Visitable() {
   }
 
+  /**
+   * nodes are allocated from the arena installed on the calling thread
+   */
+  static void* operator new(std::size_t size) {
+    return AstArena::Allocate(size);
+  }
+
+  static void operator delete(void* pointer) {
+    AstArena::Deallocate(pointer);
+  }
+
   virtual void accept(Visitor_ptr) = 0;
   virtual void visit_children(Visitor_ptr) = 0;
 
@@ -12,7 +12,7 @@ namespace Solver {
 
 using namespace SMT;
 
-int Ast2Dot::name_counter = 0;
+std::atomic<int> Ast2Dot::name_counter {0};
 
 Ast2Dot::Ast2Dot(std::ostream* out)
         : m_out(out), count(0) {
@@ -0,0 +1,116 @@
+/*
+ * CacheKeyGenerator.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "CacheKeyGenerator.h"
+
+namespace Vlab {
+namespace Solver {
+
+using namespace SMT;
+
+const int CacheKeyGenerator::VLOG_LEVEL = 20;
+
+CacheKeyGenerator::CacheKeyGenerator(Script_ptr script, SymbolTable_ptr symbol_table)
+    : AstTraverser(script),
+      symbol_table_(symbol_table) {
+  setCallbacks();
+}
+
+CacheKeyGenerator::~CacheKeyGenerator() {
+}
+
+void CacheKeyGenerator::start() {
+  DVLOG(VLOG_LEVEL) << "Starting the Cache Key Generator";
+  key_.str("");
+  symbol_ids_.clear();
+  key_ << "options:" << Option::Solver::USE_SIGNED_INTEGERS << Option::Solver::USE_MULTITRACK_AUTO
+       << Option::Solver::ENABLE_EQUIVALENCE_CLASSES << Option::Solver::ENABLE_DEPENDENCY_ANALYSIS
+       << Option::Solver::ENABLE_IMPLICATIONS << Option::Solver::ENABLE_LEN_IMPLICATIONS
+       << Option::Solver::ENABLE_SORTING_HEURISTICS << ":" << Util::RegularExpression::DEFAULT << "\n";
+
+  for (auto type : {Variable::Type::BOOL, Variable::Type::INT, Variable::Type::STRING}) {
+    key_ << "variables:" << static_cast<int>(type) << ":" << symbol_table_->get_num_of_variables(type) << ":"
+         << symbol_table_->get_num_of_substituted_variables(root_, type) << "\n";
+  }
+
+  Visitor::visit(root_);
+  end();
+}
+
+void CacheKeyGenerator::end() {
+  DVLOG(VLOG_LEVEL) << "cache key: " << key_.str();
+}
+
+void CacheKeyGenerator::setCallbacks() {
+  auto command_pre_callback = [this] (Command_ptr command) -> bool {
+    key_ << "(" << command->str();
+    return true;
+  };
+
+  auto command_post_callback = [this] (Command_ptr) -> bool {
+    key_ << ")";
+    return true;
+  };
+
+  auto term_pre_callback = [this] (Term_ptr term) -> bool {
+    key_ << "(" << static_cast<int>(term->type());
+    switch (term->type()) {
+      case Term::Type::INDEXOF:
+        key_ << ":" << static_cast<int>(dynamic_cast<IndexOf_ptr>(term)->getMode());
+        break;
+      case Term::Type::LASTINDEXOF:
+        key_ << ":" << static_cast<int>(dynamic_cast<LastIndexOf_ptr>(term)->getMode());
+        break;
+      case Term::Type::SUBSTRING:
+        key_ << ":" << static_cast<int>(dynamic_cast<SubString_ptr>(term)->getMode());
+        break;
+      default:
+        break;
+    }
+    return true;
+  };
+
+  auto term_post_callback = [this] (Term_ptr) -> bool {
+    key_ << ")";
+    return true;
+  };
+
+  setCommandPreCallback(command_pre_callback);
+  setTermPreCallback(term_pre_callback);
+  setCommandPostCallback(command_post_callback);
+  setTermPostCallback(term_post_callback);
+}
+
+/**
+ * Symbols are replaced with their order of appearance, literals are kept as is
+ */
+void CacheKeyGenerator::visitPrimitive(Primitive_ptr primitive) {
+  key_ << " " << static_cast<int>(primitive->getType());
+  if (Primitive::Type::SYMBOL == primitive->getType()) {
+    auto it = symbol_ids_.find(primitive->getData());
+    if (it == symbol_ids_.end()) {
+      it = symbol_ids_.insert(std::make_pair(primitive->getData(), static_cast<int>(symbol_ids_.size()))).first;
+    }
+    key_ << ":s" << it->second;
+    auto variable = symbol_table_->get_variable_unsafe(primitive->getData());
+    if (variable not_eq nullptr) {
+      key_ << ":" << static_cast<int>(variable->getType());
+    }
+  } else {
+    key_ << ":" << primitive->getData().size() << ":" << primitive->getData();
+  }
+}
+
+std::string CacheKeyGenerator::get_key() const {
+  return key_.str();
+}
+
+} /* namespace Solver */
+} /* namespace Vlab */
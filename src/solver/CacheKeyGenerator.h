@@ -0,0 +1,60 @@
+/*
+ * CacheKeyGenerator.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SRC_SOLVER_CACHEKEYGENERATOR_H_
+#define SRC_SOLVER_CACHEKEYGENERATOR_H_
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#include <glog/logging.h>
+
+#include "../smt/ast.h"
+#include "../smt/typedefs.h"
+#include "../smt/Visitor.h"
+#include "../utils/RegularExpression.h"
+#include "AstTraverser.h"
+#include "options/Solver.h"
+#include "SymbolTable.h"
+
+namespace Vlab {
+namespace Solver {
+
+/**
+ * Generates a normalized textual key of an optimized script. Symbols are renamed
+ * in the order they first appear, so alpha-equivalent scripts share a key.
+ * Options that change the result and the variable counts used by the model counter
+ * are part of the key.
+ */
+class CacheKeyGenerator : public AstTraverser {
+ public:
+  CacheKeyGenerator(SMT::Script_ptr, SymbolTable_ptr);
+  virtual ~CacheKeyGenerator();
+  void start() override;
+  void end() override;
+  void setCallbacks();
+
+  void visitPrimitive(SMT::Primitive_ptr) override;
+
+  std::string get_key() const;
+
+ protected:
+  SymbolTable_ptr symbol_table_;
+  std::stringstream key_;
+  std::map<std::string, int> symbol_ids_;
+ private:
+  static const int VLOG_LEVEL;
+};
+
+} /* namespace Solver */
+} /* namespace Vlab */
+
+#endif /* SRC_SOLVER_CACHEKEYGENERATOR_H_ */
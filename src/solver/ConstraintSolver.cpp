@@ -18,6 +18,7 @@ const int ConstraintSolver::VLOG_LEVEL = 11;
 ConstraintSolver::ConstraintSolver(Script_ptr script, SymbolTable_ptr symbol_table,
                                    ConstraintInformation_ptr constraint_information)
     : iteration_count_ { 0 },
+      let_depth_ { 0 },
       root_(script),
       symbol_table_(symbol_table),
       constraint_information_(constraint_information),
@@ -28,6 +29,9 @@ ConstraintSolver::ConstraintSolver(Script_ptr script, SymbolTable_ptr symbol_tab
 }
 
 ConstraintSolver::~ConstraintSolver() {
+  for (auto& entry : constant_automata_) {
+    delete entry.second;
+  }
 }
 
 void ConstraintSolver::start() {
@@ -55,7 +59,14 @@ void ConstraintSolver::end() {
 
 void ConstraintSolver::visitScript(Script_ptr script) {
   symbol_table_->push_scope(script);
-  Visitor::visit_children_of(script);
+  // assertions are conjoined, the first unsatisfiable one decides the result
+  for (auto& command : *(script->command_list)) {
+    visit(command);
+    if (not symbol_table_->isSatisfiable()) {
+      DVLOG(VLOG_LEVEL) << "unsatisfiable assertion, remaining assertions are skipped";
+      break;
+    }
+  }
   symbol_table_->pop_scope();  // global scope, it is reachable via script pointer all the time
 }
 
@@ -96,6 +107,7 @@ void ConstraintSolver::visitLet(Let_ptr let_term) {
   DVLOG(VLOG_LEVEL) << "visit: " << *let_term;
 
   symbol_table_->push_scope(let_term);
+  ++let_depth_;
 
   Value_ptr param = nullptr;
   for (auto& var_binding : *(let_term->var_binding_list)) {
@@ -117,6 +129,7 @@ void ConstraintSolver::visitLet(Let_ptr let_term) {
   check_and_visit(let_term->term);
   path_trace_.pop_back();
   param = getTermValue(let_term->term);
+  --let_depth_;
   symbol_table_->pop_scope();
 
   Value_ptr result = param->clone();
@@ -148,6 +161,11 @@ void ConstraintSolver::visitAnd(And_ptr and_term) {
 
   DVLOG(VLOG_LEVEL) << "visit children start: " << *and_term << "@" << and_term;
 
+  if (is_satisfiable and iteration_count_ == 0
+      and (constraint_information_->has_mixed_constraint(and_term) or (not is_component))) {
+    is_satisfiable = check_string_constant_constraints(and_term);
+  }
+
   if (is_satisfiable and (constraint_information_->has_mixed_constraint(and_term) or (not is_component))) {
     for (auto& term : *(and_term->term_list)) {
       is_satisfiable = check_and_visit(term) and is_satisfiable;
@@ -582,6 +600,9 @@ void ConstraintSolver::visitLe(Le_ptr le_term) {
 }
 
 void ConstraintSolver::visitConcat(Concat_ptr concat_term) {
+  if (load_memoized_value(concat_term)) {
+    return;
+  }
   DVLOG(VLOG_LEVEL) << "visit: " << *concat_term << " ...";
 
   Value_ptr result = nullptr, concat_value = nullptr, param = nullptr;
@@ -607,7 +628,7 @@ void ConstraintSolver::visitIn(In_ptr in_term) {
     if(TermConstant_ptr right_constant = dynamic_cast<TermConstant_ptr>(in_term->right_term)) {
 
       Variable_ptr var = symbol_table_->get_variable(left_var->getVarName());
-      StringAutomaton_ptr con = StringAutomaton::makeRegexAuto(right_constant->getValue());
+      StringAutomaton_ptr con = take_constant_automaton(right_constant);
       bool res = true;
       Value_ptr val = new Value(con);
 
@@ -662,6 +683,9 @@ void ConstraintSolver::visitNotIn(NotIn_ptr not_in_term) {
 }
 
 void ConstraintSolver::visitLen(Len_ptr len_term) {
+  if (load_memoized_value(len_term)) {
+    return;
+  }
   visit_children_of(len_term);
   DVLOG(VLOG_LEVEL) << "visit: " << *len_term;
 
@@ -816,6 +840,9 @@ void ConstraintSolver::visitNotEnds(NotEnds_ptr not_ends_term) {
 }
 
 void ConstraintSolver::visitIndexOf(IndexOf_ptr index_of_term) {
+  if (load_memoized_value(index_of_term)) {
+    return;
+  }
   visit_children_of(index_of_term);
 
   DVLOG(VLOG_LEVEL) << "visit: " << *index_of_term;
@@ -836,6 +863,9 @@ void ConstraintSolver::visitIndexOf(IndexOf_ptr index_of_term) {
 }
 
 void ConstraintSolver::visitLastIndexOf(LastIndexOf_ptr last_index_of_term) {
+  if (load_memoized_value(last_index_of_term)) {
+    return;
+  }
   visit_children_of(last_index_of_term);
   DVLOG(VLOG_LEVEL) << "visit: " << *last_index_of_term;
 
@@ -855,6 +885,9 @@ void ConstraintSolver::visitLastIndexOf(LastIndexOf_ptr last_index_of_term) {
 }
 
 void ConstraintSolver::visitCharAt(CharAt_ptr char_at_term) {
+  if (load_memoized_value(char_at_term)) {
+    return;
+  }
   visit_children_of(char_at_term);
   DVLOG(VLOG_LEVEL) << "visit: " << *char_at_term;
 
@@ -866,6 +899,9 @@ void ConstraintSolver::visitCharAt(CharAt_ptr char_at_term) {
 }
 
 void ConstraintSolver::visitSubString(SubString_ptr sub_string_term) {
+  if (load_memoized_value(sub_string_term)) {
+    return;
+  }
   visit_children_of(sub_string_term);
   DVLOG(VLOG_LEVEL) << "visit: " << *sub_string_term;
   Value_ptr result = nullptr, param_subject = getTermValue(sub_string_term->subject_term), param_start_index =
@@ -966,6 +1002,9 @@ void ConstraintSolver::visitSubString(SubString_ptr sub_string_term) {
 }
 
 void ConstraintSolver::visitToUpper(ToUpper_ptr to_upper_term) {
+  if (load_memoized_value(to_upper_term)) {
+    return;
+  }
   visit_children_of(to_upper_term);
   DVLOG(VLOG_LEVEL) << "visit: " << *to_upper_term;
 
@@ -976,6 +1015,9 @@ void ConstraintSolver::visitToUpper(ToUpper_ptr to_upper_term) {
 }
 
 void ConstraintSolver::visitToLower(ToLower_ptr to_lower_term) {
+  if (load_memoized_value(to_lower_term)) {
+    return;
+  }
   visit_children_of(to_lower_term);
   DVLOG(VLOG_LEVEL) << "visit: " << *to_lower_term;
 
@@ -986,6 +1028,9 @@ void ConstraintSolver::visitToLower(ToLower_ptr to_lower_term) {
 }
 
 void ConstraintSolver::visitTrim(Trim_ptr trim_term) {
+  if (load_memoized_value(trim_term)) {
+    return;
+  }
   visit_children_of(trim_term);
   DVLOG(VLOG_LEVEL) << "visit: " << *trim_term;
 
@@ -997,6 +1042,9 @@ void ConstraintSolver::visitTrim(Trim_ptr trim_term) {
 }
 
 void ConstraintSolver::visitToString(ToString_ptr to_string_term) {
+  if (load_memoized_value(to_string_term)) {
+    return;
+  }
   visit_children_of(to_string_term);
   DVLOG(VLOG_LEVEL) << "visit: " << *to_string_term;
 
@@ -1016,6 +1064,9 @@ void ConstraintSolver::visitToString(ToString_ptr to_string_term) {
 }
 
 void ConstraintSolver::visitToInt(ToInt_ptr to_int_term) {
+  if (load_memoized_value(to_int_term)) {
+    return;
+  }
   visit_children_of(to_int_term);
   DVLOG(VLOG_LEVEL) << "visit: " << *to_int_term;
 
@@ -1033,6 +1084,9 @@ void ConstraintSolver::visitToInt(ToInt_ptr to_int_term) {
 }
 
 void ConstraintSolver::visitReplace(Replace_ptr replace_term) {
+  if (load_memoized_value(replace_term)) {
+    return;
+  }
   visit_children_of(replace_term);
   DVLOG(VLOG_LEVEL) << "visit: " << *replace_term;
 
@@ -1152,10 +1206,10 @@ void ConstraintSolver::visitTermConstant(TermConstant_ptr term_constant) {
       // TODO instead we may use string constants before going into automaton
       // and keep it unless we need automaton
       // this may complicate the code with a perf gain ??
-      result = new Value(Theory::StringAutomaton::makeString(term_constant->getValue()));
+      result = new Value(take_constant_automaton(term_constant));
       break;
       case Primitive::Type::REGEX:
-      result = new Value(Theory::StringAutomaton::makeRegexAuto(term_constant->getValue()));
+      result = new Value(take_constant_automaton(term_constant));
       break;
       default:
       LOG(FATAL) << "unhandled term constant: " << *term_constant;
@@ -1233,9 +1287,68 @@ void ConstraintSolver::clearTermValuesAndLocalLetVars() {
     delete entry.second;
   }
   term_values_.clear();
+  memoized_terms_.clear();
   symbol_table_->clearLetScopes();
 }
 
+/**
+ * A term structurally equal to a term visited after the last variable update takes clones of the
+ * values of that term and of its sub terms, variables are visited as usual to record their paths.
+ * Otherwise the term is recorded for the terms that follow.
+ * @returns true if the value of the term is set
+ */
+bool ConstraintSolver::load_memoized_value(Term_ptr term) {
+  if (let_depth_ > 0) {  // let bound symbols may shadow variables
+    return false;
+  }
+
+  TermKeyGenerator key_generator(term);
+  key_generator.start();
+  if (not key_generator.is_memoizable()) {
+    return false;
+  }
+
+  auto it = memoized_terms_.find(key_generator.get_key());
+  if (it == memoized_terms_.end()) {
+    memoized_terms_[key_generator.get_key()] = key_generator.get_terms();
+    return false;
+  }
+
+  const auto& memoized_terms = it->second;
+  if (term_values_.find(memoized_terms.front()) == term_values_.end()) {
+    return false;
+  }
+
+  DVLOG(VLOG_LEVEL) << "memoized value: " << *term << "@" << term;
+  std::size_t position = 0;
+  std::vector<Term_ptr> memoized_parents;
+  AstTraverser value_loader(nullptr);
+  value_loader.setTermPreCallback([&](Term_ptr sub_term) -> bool {
+    auto memoized_term = memoized_terms[position++];
+    if (Term::Type::QUALIDENTIFIER == sub_term->type()) {
+      visitQualIdentifier(dynamic_cast<QualIdentifier_ptr>(sub_term));
+      return false;
+    } else if (Term::Type::TERMCONSTANT == sub_term->type()) {
+      setTermValue(sub_term, getTermValue(memoized_term)->clone());
+      return false;
+    }
+    path_trace_.push_back(sub_term);
+    memoized_parents.push_back(memoized_term);
+    return true;
+  });
+  value_loader.setTermPostCallback([&](Term_ptr sub_term) -> bool {
+    if (Term::Type::QUALIDENTIFIER == sub_term->type() or Term::Type::TERMCONSTANT == sub_term->type()) {
+      return true;
+    }
+    path_trace_.pop_back();
+    setTermValue(sub_term, getTermValue(memoized_parents.back())->clone());
+    memoized_parents.pop_back();
+    return true;
+  });
+  value_loader.visit(term);
+  return true;
+}
+
 void ConstraintSolver::setVariablePath(QualIdentifier_ptr qi_term) {
   path_trace_.push_back(qi_term);
   variable_path_table_.push_back(std::vector<Term_ptr>());
@@ -1249,6 +1362,7 @@ bool ConstraintSolver::update_variables() {
     return true;
   }
 
+  memoized_terms_.clear();  // memoized values are computed from the previous variable values
   VariableValueComputer value_updater(symbol_table_, variable_path_table_, term_values_);
   value_updater.start();
   auto is_satisfiable = value_updater.is_satisfiable();
@@ -1297,8 +1411,96 @@ bool ConstraintSolver::check_and_visit(Term_ptr term) {
   return param->is_satisfiable();
 }
 
+/**
+ * Intersects the constant membership constraints of each single track string variable lazily
+ * before the conjuncts are visited, an unsatisfiable conjunction is rejected without building
+ * the intersection automata. Runs only in the first iteration, constant automata of a satisfiable
+ * conjunction are kept for the constant terms.
+ */
+bool ConstraintSolver::check_string_constant_constraints(And_ptr and_term) {
+  std::map<Variable_ptr, std::vector<StringAutomaton_ptr>> constant_automata;
+  std::map<TermConstant_ptr, StringAutomaton_ptr> term_automata;
+  for (auto term : *(and_term->term_list)) {
+    QualIdentifier_ptr left_var = nullptr;
+    TermConstant_ptr right_constant = nullptr;
+    if (In_ptr in_term = dynamic_cast<In_ptr>(term)) {
+      left_var = dynamic_cast<QualIdentifier_ptr>(in_term->left_term);
+      right_constant = dynamic_cast<TermConstant_ptr>(in_term->right_term);
+    } else if (Eq_ptr eq_term = dynamic_cast<Eq_ptr>(term)) {
+      // equality is symmetric, constant may be on either side
+      left_var = dynamic_cast<QualIdentifier_ptr>(eq_term->left_term);
+      right_constant = dynamic_cast<TermConstant_ptr>(eq_term->right_term);
+      if (left_var == nullptr and right_constant == nullptr) {
+        left_var = dynamic_cast<QualIdentifier_ptr>(eq_term->right_term);
+        right_constant = dynamic_cast<TermConstant_ptr>(eq_term->left_term);
+      }
+    }
+
+    if (left_var == nullptr or right_constant == nullptr
+        or (Primitive::Type::STRING not_eq right_constant->getValueType()
+            and Primitive::Type::REGEX not_eq right_constant->getValueType())) {
+      continue;
+    }
+    Variable_ptr variable = symbol_table_->get_variable(left_var->getVarName());
+    if (Variable::Type::STRING not_eq variable->getType() or string_constraint_solver_.has_variable(variable)) {
+      continue;
+    }
+    auto constant_auto = make_constant_automaton(right_constant);
+    constant_automata[variable].push_back(constant_auto);
+    term_automata[right_constant] = constant_auto;
+  }
+
+  bool is_satisfiable = true;
+  for (auto& entry : constant_automata) {
+    if (is_satisfiable and entry.second.size() > 1) {
+      LazyIntersection lazy_intersection(entry.second);
+      Value_ptr variable_value = symbol_table_->get_value(entry.first);
+      if (variable_value not_eq nullptr and Value::Type::STRING_AUTOMATON == variable_value->getType()) {
+        lazy_intersection.Add(variable_value->getStringAutomaton());
+      }
+      is_satisfiable = not lazy_intersection.IsEmpty();
+      DVLOG(VLOG_LEVEL) << "constant constraints of " << *entry.first << (is_satisfiable ? " are" : " are not")
+                        << " satisfiable";
+    }
+  }
+
+  // satisfiable constraints are solved next, their constants reuse the automata
+  for (auto& entry : term_automata) {
+    if (is_satisfiable) {
+      constant_automata_[entry.first] = entry.second;
+    } else {
+      delete entry.second;
+    }
+  }
+  return is_satisfiable;
+}
+
+/**
+ * Builds the automaton of a string or regex constant, all constant automata are built here
+ */
+StringAutomaton_ptr ConstraintSolver::make_constant_automaton(TermConstant_ptr term_constant) {
+  if (Primitive::Type::REGEX == term_constant->getValueType()) {
+    return StringAutomaton::makeRegexAuto(term_constant->getValue());
+  }
+  return StringAutomaton::makeString(term_constant->getValue());
+}
+
+/**
+ * Takes over the automaton built for the constant while checking string constant constraints,
+ * builds it otherwise
+ */
+StringAutomaton_ptr ConstraintSolver::take_constant_automaton(TermConstant_ptr term_constant) {
+  auto it = constant_automata_.find(term_constant);
+  if (it == constant_automata_.end()) {
+    return make_constant_automaton(term_constant);
+  }
+  auto constant_auto = it->second;
+  constant_automata_.erase(it);
+  return constant_auto;
+}
+
 bool ConstraintSolver::process_mixed_integer_string_constraints_in(Term_ptr term) {
-  UnaryAutomaton_ptr string_term_unary_auto = nullptr;
+  SemilinearSet_ptr string_term_semilinear_set = nullptr;
   BinaryIntAutomaton_ptr string_term_binary_auto = nullptr, updated_arith_auto = nullptr;
   IntAutomaton_ptr updated_int_auto = nullptr;
   bool has_minus_one = false;
@@ -1324,12 +1526,10 @@ bool ConstraintSolver::process_mixed_integer_string_constraints_in(Term_ptr term
       has_minus_one = string_term_result->getIntAutomaton()->hasNegative1();
       number_of_variables_for_int_auto = string_term_result->getIntAutomaton()->getNumberOfVariables();
 
-      // first convert integer result to unary, then unary to binary
-      string_term_unary_auto = string_term_result->getIntAutomaton()->toUnaryAutomaton();
-      string_term_binary_auto = string_term_unary_auto->toBinaryIntAutomaton(
+      // semilinear set is kept to skip extracting it again if arithmetic does not restrict the string term
+      string_term_semilinear_set = string_term_result->getIntAutomaton()->getSemilinearSet();
+      string_term_binary_auto = string_term_result->getIntAutomaton()->toBinaryIntAutomaton(
           string_term_var_name, arithmetic_result->getBinaryIntAutomaton()->get_formula()->clone(), has_minus_one);
-      delete string_term_unary_auto;
-      string_term_unary_auto = nullptr;
     } else if (Value::Type::INT_CONSTANT == string_term_result->getType()) {
       int value = string_term_result->getIntConstant();
       has_minus_one = (value < 0);
@@ -1362,12 +1562,12 @@ bool ConstraintSolver::process_mixed_integer_string_constraints_in(Term_ptr term
       string_term_binary_auto = positive_values_auto;
     }
 
-    string_term_unary_auto = string_term_binary_auto->ToUnaryAutomaton();
+    updated_int_auto = string_term_binary_auto->ToIntAutomaton(number_of_variables_for_int_auto, has_minus_one,
+                                                               string_term_semilinear_set);
     delete string_term_binary_auto;
     string_term_binary_auto = nullptr;
-    updated_int_auto = string_term_unary_auto->toIntAutomaton(number_of_variables_for_int_auto, has_minus_one);
-    delete string_term_unary_auto;
-    string_term_unary_auto = nullptr;
+    delete string_term_semilinear_set;
+    string_term_semilinear_set = nullptr;
     clearTermValue(string_term);
     string_term_result = new Value(updated_int_auto);
     setTermValue(string_term, string_term_result);
@@ -1382,6 +1582,7 @@ bool ConstraintSolver::process_mixed_integer_string_constraints_in(Term_ptr term
       break;
     }
   }
+  delete string_term_semilinear_set;
   return is_satisfiable;
 }
 
@@ -22,6 +22,7 @@
 #include "../theory/ArithmeticFormula.h"
 #include "../theory/BinaryIntAutomaton.h"
 #include "../theory/IntAutomaton.h"
+#include "../theory/LazyIntersection.h"
 #include "../theory/MultiTrackAutomaton.h"
 #include "../theory/StringAutomaton.h"
 #include "../theory/StringRelation.h"
@@ -32,6 +33,7 @@
 #include "StringRelationGenerator.h"
 #include "StringConstraintSolver.h"
 #include "SymbolTable.h"
+#include "TermKeyGenerator.h"
 #include "Value.h"
 #include "VariableValueComputer.h"
 
@@ -120,13 +122,18 @@ class ConstraintSolver: public SMT::Visitor {
   bool setTermValue(SMT::Term_ptr term, Value_ptr value);
   void clearTermValue(SMT::Term_ptr term);
   void clearTermValuesAndLocalLetVars();
+  bool load_memoized_value(SMT::Term_ptr term);
   void setVariablePath(SMT::QualIdentifier_ptr qi_term);
   bool update_variables();
   void visit_children_of(SMT::Term_ptr term);
   bool check_and_visit(SMT::Term_ptr term);
+  bool check_string_constant_constraints(SMT::And_ptr and_term);
+  Theory::StringAutomaton_ptr make_constant_automaton(SMT::TermConstant_ptr term_constant);
+  Theory::StringAutomaton_ptr take_constant_automaton(SMT::TermConstant_ptr term_constant);
   bool process_mixed_integer_string_constraints_in(SMT::Term_ptr term);
 
   int iteration_count_;
+  int let_depth_;
   SMT::Script_ptr root_;
   SymbolTable_ptr symbol_table_;
   ConstraintInformation_ptr constraint_information_;
@@ -136,6 +143,18 @@ class ConstraintSolver: public SMT::Visitor {
 
   TermValueMap term_values_;
 
+  /**
+   * Sub terms in pre-order of the first term with a given key (see TermKeyGenerator) visited
+   * after the last variable update, their values are reused for structurally equal terms
+   */
+  std::map<std::string, std::vector<SMT::Term_ptr>> memoized_terms_;
+
+  /**
+   * Automata built while checking string constant constraints, handed over to the
+   * constant terms when they are visited
+   */
+  std::map<SMT::TermConstant_ptr, Theory::StringAutomaton_ptr> constant_automata_;
+
   std::vector<SMT::Term_ptr> path_trace_;
   VariablePathTable variable_path_table_;
 
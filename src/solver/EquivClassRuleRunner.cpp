@@ -35,6 +35,21 @@ void EquivClassRuleRunner::start() {
 
   end();
 }
+
+/**
+ * Substitutes a single conjunct of the root scope, the caller optimizes it
+ */
+void EquivClassRuleRunner::start(Term_ptr& term) {
+  if (not has_optimization_rules()) {
+    return;
+  }
+
+  symbol_table_->push_scope(root, false);
+  check_and_substitute_var(term);
+  visit(term);
+  symbol_table_->pop_scope();
+}
+
 void EquivClassRuleRunner::end() {
   SyntacticOptimizer syntactic_optimizer(root, symbol_table_);
   syntactic_optimizer.start();
@@ -34,6 +34,7 @@ class EquivClassRuleRunner: public SMT::Visitor {
   EquivClassRuleRunner(SMT::Script_ptr, SymbolTable_ptr);
   virtual ~EquivClassRuleRunner();
   void start() override;
+  void start(SMT::Term_ptr& term);
   void end() override;
 
   void visitScript(SMT::Script_ptr) override;
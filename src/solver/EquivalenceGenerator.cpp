@@ -31,12 +31,32 @@ EquivalenceGenerator::EquivalenceGenerator(Script_ptr script, SymbolTable_ptr sy
 EquivalenceGenerator::~EquivalenceGenerator() {
 }
 
+/**
+ * Runs until a fixpoint over a worklist of conjuncts: each round visits the conjuncts that changed
+ * in the previous round and substitutes only the conjuncts that mention an updated variable
+ */
 void EquivalenceGenerator::start() {
   DVLOG(VLOG_LEVEL) << "Starting the EquivalenceGenerator";
-  has_constant_substitution_ = false;
-  symbol_table_->push_scope(root_, false);
-  visitScript(root_);
-  symbol_table_->pop_scope();
+  conjuncts_.clear();
+  variable_conjuncts_.clear();
+  for (auto command : *(root_->command_list)) {
+    if (Assert_ptr assert_command = dynamic_cast<Assert_ptr>(command)) {
+      index_conjuncts(assert_command->term);
+    }
+  }
+
+  std::set<std::size_t> conjunct_ids;
+  for (std::size_t id = 0; id < conjuncts_.size(); ++id) {
+    conjunct_ids.insert(id);
+  }
+
+  do {
+    has_constant_substitution_ = false;
+    updated_variables_.clear();
+    visit_conjuncts(conjunct_ids);
+    conjunct_ids = substitute_updated_variables();
+  } while (has_constant_substitution_ and not conjunct_ids.empty());
+
   end();
 }
 
@@ -56,8 +76,9 @@ void EquivalenceGenerator::end() {
   }
 #endif
 
-  EquivClassRuleRunner rule_runner(root_, symbol_table_);
-  rule_runner.start();
+  // substitutions may leave boolean constants in the conjunctions
+  SyntacticOptimizer syntactic_optimizer(root_, symbol_table_);
+  syntactic_optimizer.start();
 }
 
 void EquivalenceGenerator::setCallbacks() {
@@ -152,6 +173,78 @@ bool EquivalenceGenerator::has_constant_substitution() {
   return has_constant_substitution_;
 }
 
+/**
+ * Conjunctions at the root scope are flattened, other terms are conjuncts
+ */
+void EquivalenceGenerator::index_conjuncts(Term_ptr& term) {
+  if (And_ptr and_term = dynamic_cast<And_ptr>(term)) {
+    for (auto& sub_term : *(and_term->term_list)) {
+      index_conjuncts(sub_term);
+    }
+    return;
+  }
+  conjuncts_.push_back(&term);
+  index_variables_of(conjuncts_.size() - 1);
+}
+
+void EquivalenceGenerator::index_variables_of(std::size_t conjunct_id) {
+  AstTraverser variable_collector(root_);
+  variable_collector.setTermPreCallback([this, conjunct_id](Term_ptr term) -> bool {
+    if (QualIdentifier_ptr qi_term = dynamic_cast<QualIdentifier_ptr>(term)) {
+      auto variable = symbol_table_->get_variable_unsafe(qi_term->getVarName());
+      if (variable) {
+        variable_conjuncts_[variable].insert(conjunct_id);
+      }
+    }
+    return true;
+  });
+  variable_collector.visit(*conjuncts_[conjunct_id]);
+}
+
+/**
+ * Same order with @visitAnd, disjunctions are visited last
+ */
+void EquivalenceGenerator::visit_conjuncts(const std::set<std::size_t>& conjunct_ids) {
+  std::vector<std::size_t> or_conjunct_ids;
+  symbol_table_->push_scope(root_, false);
+  for (auto id : conjunct_ids) {
+    if (Term::Type::OR not_eq (*conjuncts_[id])->type()) {
+      visit(*conjuncts_[id]);
+    } else {
+      or_conjunct_ids.push_back(id);
+    }
+  }
+  for (auto id : or_conjunct_ids) {
+    visit(*conjuncts_[id]);
+  }
+  symbol_table_->pop_scope();
+}
+
+/**
+ * Applies equivalence classes to the conjuncts that mention an updated variable
+ * @return ids of the updated conjuncts
+ */
+std::set<std::size_t> EquivalenceGenerator::substitute_updated_variables() {
+  std::set<std::size_t> conjunct_ids;
+  for (auto variable : updated_variables_) {
+    auto it = variable_conjuncts_.find(variable);
+    if (it != variable_conjuncts_.end()) {
+      conjunct_ids.insert(it->second.begin(), it->second.end());
+    }
+  }
+
+  EquivClassRuleRunner rule_runner(root_, symbol_table_);
+  SyntacticOptimizer syntactic_optimizer(root_, symbol_table_);
+  for (auto id : conjunct_ids) {
+    rule_runner.start(*conjuncts_[id]);
+    syntactic_optimizer.start(*conjuncts_[id]);
+    // representative variables are mentioned after substitution
+    index_variables_of(id);
+  }
+  DVLOG(VLOG_LEVEL) << "substituted " << conjunct_ids.size() << " of " << conjuncts_.size() << " conjuncts";
+  return conjunct_ids;
+}
+
 /**
  * checks and sets members variables @left_variable_, @right_variable based on result
  */
@@ -220,10 +313,15 @@ bool EquivalenceGenerator::is_equiv_of_bool_var_and_term(SMT::Term_ptr left_term
 void EquivalenceGenerator::update_equiv_class_and_symbol_table(EquivalenceClass_ptr left_equiv,
                                                                EquivalenceClass_ptr right_equiv) {
 //  DVLOG(VLOG_LEVEL)<< "merge: " << *left_equiv << " U " << *right_equiv;
+  if (left_equiv == right_equiv) {
+    return;
+  }
   left_equiv->merge(right_equiv);
   for (auto variable : right_equiv->get_variables()) {
     symbol_table_->add_variable_equiv_class_mapping(variable, left_equiv);
+    updated_variables_.insert(variable);
   }
+  updated_variables_.insert(left_equiv->get_representative_variable());
   delete right_equiv;
 }
 
@@ -231,16 +329,19 @@ void EquivalenceGenerator::update_equiv_class_and_symbol_table(EquivalenceClass_
 //  DVLOG(VLOG_LEVEL)<< "add variable: " << variable->getName() << " >> " << *equiv;
   equiv->add(variable);
   symbol_table_->add_variable_equiv_class_mapping(variable, equiv);
+  updated_variables_.insert(variable);
 }
 
 void EquivalenceGenerator::update_equiv_class_and_symbol_table(EquivalenceClass_ptr equiv, SMT::TermConstant_ptr term_constant) {
 //  DVLOG(VLOG_LEVEL)<< "constant: \"" << term_constant->getValue() << "\" >> " << *equiv;
   equiv->add(term_constant);
+  updated_variables_.insert(equiv->get_representative_variable());
 }
 
 void EquivalenceGenerator::update_equiv_class_and_symbol_table(EquivalenceClass_ptr equiv, SMT::Term_ptr term) {
   DVLOG(VLOG_LEVEL)<< "add term: " << *term << " >> " << *equiv;
   equiv->add(term);
+  updated_variables_.insert(equiv->get_representative_variable());
 }
 
 void EquivalenceGenerator::create_equiv_class_and_update_symbol_table(SMT::Variable_ptr left_variable,
@@ -248,16 +349,20 @@ void EquivalenceGenerator::create_equiv_class_and_update_symbol_table(SMT::Varia
   auto equiv = new EquivalenceClass(left_variable, right_variable);
   symbol_table_->add_variable_equiv_class_mapping(left_variable, equiv);
   symbol_table_->add_variable_equiv_class_mapping(right_variable, equiv);
+  updated_variables_.insert(left_variable);
+  updated_variables_.insert(right_variable);
 }
 
 void EquivalenceGenerator::create_equiv_class_and_update_symbol_table(SMT::Variable_ptr variable, SMT::TermConstant_ptr term_constant) {
   auto equiv = new EquivalenceClass(variable, term_constant);
   symbol_table_->add_variable_equiv_class_mapping(variable, equiv);
+  updated_variables_.insert(variable);
 }
 
 void EquivalenceGenerator::create_equiv_class_and_update_symbol_table(SMT::Variable_ptr variable, SMT::Term_ptr term) {
   auto equiv = new EquivalenceClass(variable, term);
   symbol_table_->add_variable_equiv_class_mapping(variable, equiv);
+  updated_variables_.insert(variable);
 }
 
 } /* namespace Solver */
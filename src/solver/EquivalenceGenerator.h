@@ -11,7 +11,9 @@
 #ifndef SOLVER_EQUIVALENCEGENERATOR_H_
 #define SOLVER_EQUIVALENCEGENERATOR_H_
 
+#include <cstddef>
 #include <iostream>
+#include <map>
 #include <set>
 #include <string>
 #include <utility>
@@ -45,6 +47,10 @@ class EquivalenceGenerator : public AstTraverser {
 
   bool has_constant_substitution();
  protected:
+  void index_conjuncts(SMT::Term_ptr& term);
+  void index_variables_of(std::size_t conjunct_id);
+  void visit_conjuncts(const std::set<std::size_t>& conjunct_ids);
+  std::set<std::size_t> substitute_updated_variables();
   bool is_equiv_of_variables(SMT::Term_ptr left_term, SMT::Term_ptr right_term);
   bool is_equiv_of_variable_and_constant(SMT::Term_ptr left_term, SMT::Term_ptr right_term);
   bool is_equiv_of_bool_var_and_term(SMT::Term_ptr left_term, SMT::Term_ptr right_term);
@@ -63,6 +69,14 @@ class EquivalenceGenerator : public AstTraverser {
   SMT::Variable_ptr right_variable_;
   SMT::TermConstant_ptr term_constant_;
   SMT::Term_ptr unclassified_term_;
+
+  /**
+   * conjuncts at the root scope with the variables they mention, only the conjuncts that mention
+   * a variable with an updated equivalence class are substituted and visited again
+   */
+  std::vector<SMT::Term_ptr*> conjuncts_;
+  std::map<SMT::Variable_ptr, std::set<std::size_t>> variable_conjuncts_;
+  std::set<SMT::Variable_ptr> updated_variables_;
  private:
   static const int VLOG_LEVEL;
 };
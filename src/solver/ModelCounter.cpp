@@ -10,7 +10,7 @@
 namespace Vlab {
 namespace Solver {
 
-ModelCounter::ModelCounter() : use_signed_integers_{true}, unconstraint_int_vars_ {0}, unconstraint_str_vars_ {0} {
+ModelCounter::ModelCounter() : use_signed_integers_{true}, num_threads_ {1}, unconstraint_int_vars_ {0}, unconstraint_str_vars_ {0} {
 }
 
 ModelCounter::~ModelCounter() {
@@ -20,6 +20,10 @@ void ModelCounter::set_use_sign_integers(bool value) {
   use_signed_integers_ = value;
 }
 
+void ModelCounter::set_num_threads(int n) {
+  num_threads_ = n;
+}
+
 void ModelCounter::set_num_of_unconstraint_int_vars(int n) {
   unconstraint_int_vars_ = n;
 }
@@ -39,74 +43,147 @@ void ModelCounter::add_symbolic_counter(const Theory::SymbolicCounter& counter)
 
 
 Theory::BigInteger ModelCounter::CountInts(const unsigned long bound) {
-  Theory::BigInteger result(1);
+  return CountInts(std::vector<unsigned long> {bound}).front();
+}
 
-  for (int i : constant_ints_) {
-    Theory::BigInteger value(i);
-    auto shift = bound;
+Theory::BigInteger ModelCounter::CountStrs(const unsigned long bound) {
+  return CountStrs(std::vector<unsigned long> {bound}).front();
+}
 
-    Theory::BigInteger base(1);
-    Theory::BigInteger upper_bound = (base << shift) - 1;
+Theory::BigInteger ModelCounter::Count(const unsigned long int_bound, const unsigned long str_bound) {
+  return CountInts(int_bound) * CountStrs(str_bound);
+}
 
-    Theory::BigInteger lower_bound(0);
-    if (use_signed_integers_) {
-      Theory::BigInteger base2(-1);
-      lower_bound = (base2 << shift) + 1;
-    }
+/**
+ * Each symbolic counter counts all bounds in a single forward pass
+ */
+std::vector<Theory::BigInteger> ModelCounter::CountInts(const std::vector<unsigned long>& bounds) {
+  std::vector<Theory::BigInteger> results(bounds.size(), 1);
+  std::vector<bool> is_out_of_range(bounds.size(), false);
 
-    if (not (value <= upper_bound and value >= lower_bound)) {
-     return 0; // no need to compute further
+  for (int i : constant_ints_) {
+    Theory::BigInteger value(i);
+    for (std::size_t b = 0; b < bounds.size(); ++b) {
+      auto shift = bounds[b];
+
+      Theory::BigInteger base(1);
+      Theory::BigInteger upper_bound = (base << shift) - 1;
+
+      Theory::BigInteger lower_bound(0);
+      if (use_signed_integers_) {
+        Theory::BigInteger base2(-1);
+        lower_bound = (base2 << shift) + 1;
+      }
+
+      if (not (value <= upper_bound and value >= lower_bound)) {
+        is_out_of_range[b] = true;
+        results[b] = 0;
+      }
     }
   }
 
+  if (std::all_of(is_out_of_range.begin(), is_out_of_range.end(), [](bool v) { return v; })) {
+    return results; // no need to compute further
+  }
 
-  for (Theory::SymbolicCounter& counter : symbolic_counters_) {
-    if (Theory::SymbolicCounter::Type::STRING != counter.type()) {
-      result = result * counter.Count(bound);
-    }
+  auto counts = CountSymbolicCounters(false, bounds);
+  for (std::size_t b = 0; b < bounds.size(); ++b) {
+    results[b] = results[b] * counts[b];
   }
 
   if (unconstraint_int_vars_ > 0) {
-   if (use_signed_integers_) {
-     result = result
+    for (std::size_t b = 0; b < bounds.size(); ++b) {
+      if (use_signed_integers_) {
+        results[b] = results[b]
             * boost::multiprecision::pow(
                 (boost::multiprecision::pow(
                     boost::multiprecision::cpp_int(2),
-                    (2 * bound)) - 1),
+                    (2 * bounds[b])) - 1),
                 unconstraint_int_vars_);
-   } else {
-     result = result
-         * boost::multiprecision::pow(boost::multiprecision::cpp_int(2),
-                                      (unconstraint_int_vars_ * bound));
-   }
+      } else {
+        results[b] = results[b]
+            * boost::multiprecision::pow(boost::multiprecision::cpp_int(2),
+                                         (unconstraint_int_vars_ * bounds[b]));
+      }
+    }
   }
 
-  return result;
+  return results;
 }
 
-Theory::BigInteger ModelCounter::CountStrs(const unsigned long bound) {
-  Theory::BigInteger result(1);
+std::vector<Theory::BigInteger> ModelCounter::CountStrs(const std::vector<unsigned long>& bounds) {
+  std::vector<Theory::BigInteger> results = CountSymbolicCounters(true, bounds);
 
-  for (Theory::SymbolicCounter& counter : symbolic_counters_) {
-    if (Theory::SymbolicCounter::Type::STRING == counter.type()) {
-      result = result * counter.Count(bound);
+  if (unconstraint_str_vars_ > 0) {
+    for (std::size_t b = 0; b < bounds.size(); ++b) {
+      Theory::BigInteger single_unconstraint_str_count = (boost::multiprecision::pow(
+          boost::multiprecision::cpp_int(256), (bounds[b] + 1)) - 1)
+              / 255;
+      results[b] = results[b]
+          * boost::multiprecision::pow(single_unconstraint_str_count,
+                                       unconstraint_str_vars_);
     }
   }
 
-  if (unconstraint_str_vars_ > 0) {
-    Theory::BigInteger single_unconstraint_str_count = (boost::multiprecision::pow(
-        boost::multiprecision::cpp_int(256), (bound + 1)) - 1)
-            / 255;
-   result = result
-       * boost::multiprecision::pow(single_unconstraint_str_count,
-                                    unconstraint_str_vars_);
-  }
+  return results;
+}
 
-  return result;
+/**
+ * Counts pairs of bounds, int_bounds[i] with str_bounds[i]
+ */
+std::vector<Theory::BigInteger> ModelCounter::Count(const std::vector<unsigned long>& int_bounds, const std::vector<unsigned long>& str_bounds) {
+  CHECK_EQ(int_bounds.size(), str_bounds.size()) << "number of int and string bounds must match";
+  auto results = CountInts(int_bounds);
+  auto str_results = CountStrs(str_bounds);
+  for (std::size_t b = 0; b < results.size(); ++b) {
+    results[b] = results[b] * str_results[b];
+  }
+  return results;
 }
 
-Theory::BigInteger ModelCounter::Count(const unsigned long int_bound, const unsigned long str_bound) {
-  return CountInts(int_bound) * CountStrs(str_bound);
+std::vector<Theory::BigInteger> ModelCounter::CountSymbolicCounters(const bool is_string, const std::vector<unsigned long>& bounds) {
+  std::vector<Theory::SymbolicCounter*> counters;
+  for (Theory::SymbolicCounter& counter : symbolic_counters_) {
+    if (is_string == (Theory::SymbolicCounter::Type::STRING == counter.type())) {
+      counters.push_back(&counter);
+    }
+  }
+
+  // each worker takes the next uncounted component, a component without models cancels the rest
+  std::vector<std::vector<Theory::BigInteger>> counts(counters.size());
+  std::atomic<std::size_t> next_counter {0};
+  std::atomic<bool> has_no_models {false};
+  const auto options = Option::Context::Current();
+  auto worker = [&]() {
+    Option::Context::Scope options_scope(options);
+    for (std::size_t i = next_counter++; i < counters.size() and not has_no_models; i = next_counter++) {
+      counts[i] = counters[i]->Count(bounds);
+      if (std::all_of(counts[i].begin(), counts[i].end(), [](const Theory::BigInteger& c) { return c == 0; })) {
+        has_no_models = true;
+      }
+    }
+  };
+
+  std::size_t num_workers = std::min(counters.size(), static_cast<std::size_t>(std::max(num_threads_, 1)));
+  std::vector<std::thread> threads;
+  for (std::size_t t = 1; t < num_workers; ++t) {
+    threads.push_back(std::thread(worker));
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<Theory::BigInteger> results(bounds.size(), has_no_models ? 0 : 1);
+  if (has_no_models) {
+    return results;
+  }
+  for (const auto& component_counts : counts) {
+    for (std::size_t b = 0; b < bounds.size(); ++b) {
+      results[b] = results[b] * component_counts[b];
+    }
+  }
+  return results;
 }
 
 std::string ModelCounter::str() const {
@@ -8,10 +8,13 @@
 #ifndef SRC_SOLVER_MODELCOUNTER_H_
 #define SRC_SOLVER_MODELCOUNTER_H_
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <glog/logging.h>
@@ -19,6 +22,7 @@
 #include "../cereal/types/vector.hpp"
 #include "../theory/SymbolicCounter.h"
 #include "../utils/Serialize.h"
+#include "options/Context.h"
 
 namespace Vlab {
 namespace Solver {
@@ -28,6 +32,7 @@ class ModelCounter {
   ModelCounter();
   virtual ~ModelCounter();
   void set_use_sign_integers(bool value);
+  void set_num_threads(int n);
   void set_num_of_unconstraint_int_vars(int n);
   void set_num_of_unconstraint_str_vars(int n);
   void add_constant(int c);
@@ -35,6 +40,9 @@ class ModelCounter {
   Theory::BigInteger CountInts(const unsigned long bound);
   Theory::BigInteger CountStrs(const unsigned long bound);
   Theory::BigInteger Count(const unsigned long int_bound, const unsigned long str_bound);
+  std::vector<Theory::BigInteger> CountInts(const std::vector<unsigned long>& bounds);
+  std::vector<Theory::BigInteger> CountStrs(const std::vector<unsigned long>& bounds);
+  std::vector<Theory::BigInteger> Count(const std::vector<unsigned long>& int_bounds, const std::vector<unsigned long>& str_bounds);
 
   template <class Archive>
   void save(Archive& ar) const {
@@ -56,7 +64,16 @@ class ModelCounter {
   std::string str() const;
   friend std::ostream& operator<<(std::ostream& os, const ModelCounter& mc);
  protected:
+  /**
+   * Counts the symbolic counters of the given type for all bounds and multiplies them.
+   * Counters belong to independent components, with more than one thread they are
+   * counted concurrently; once a component has no models for any bound the
+   * remaining ones are not counted.
+   */
+  std::vector<Theory::BigInteger> CountSymbolicCounters(const bool is_string, const std::vector<unsigned long>& bounds);
+
   bool use_signed_integers_;
+  int num_threads_;
   int unconstraint_int_vars_;
   int unconstraint_str_vars_;
   std::vector<int> constant_ints_;
@@ -0,0 +1,114 @@
+/*
+ * ModelCounterCache.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "ModelCounterCache.h"
+
+namespace Vlab {
+namespace Solver {
+
+const int ModelCounterCache::VLOG_LEVEL = 20;
+
+ModelCounterCache::ModelCounterCache(std::string directory)
+    : directory_(directory) {
+}
+
+ModelCounterCache::~ModelCounterCache() {
+}
+
+bool ModelCounterCache::Load(const std::string& key, bool& is_satisfiable, ModelCounter& model_counter) const {
+  std::string file_name = get_file_name(key);
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    DVLOG(VLOG_LEVEL) << "cache miss: " << file_name;
+    return false;
+  }
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 or file_stat.st_size == 0) {
+    close(fd);
+    return false;
+  }
+
+  void* data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    LOG(ERROR) << "cannot map cache entry: " << file_name;
+    return false;
+  }
+
+  bool is_hit = false;
+  {
+    MappedBuffer buffer(static_cast<char*>(data), file_stat.st_size);
+    std::istream is(&buffer);
+    try {
+      cereal::BinaryInputArchive ar(is);
+      std::string stored_key;
+      ar(stored_key);
+      if (stored_key == key) {
+        ar(is_satisfiable);
+        ar(model_counter);
+        is_hit = true;
+      }
+    } catch (const cereal::Exception& e) {
+      LOG(ERROR) << "cannot read cache entry: " << file_name << " (" << e.what() << ")";
+    }
+  }
+  munmap(data, file_stat.st_size);
+
+  DVLOG(VLOG_LEVEL) << "cache " << (is_hit ? "hit: " : "collision: ") << file_name;
+  return is_hit;
+}
+
+/**
+ * Writes into a temporary file first, renaming it keeps entries whole
+ * when several processes share the cache
+ */
+void ModelCounterCache::Store(const std::string& key, const bool is_satisfiable, const ModelCounter& model_counter) const {
+  std::string file_name = get_file_name(key);
+  std::string tmp_file_name = file_name + "." + std::to_string(getpid()) + "."
+      + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+  {
+    std::ofstream os(tmp_file_name, std::ios::binary);
+    if (not os.good()) {
+      LOG(ERROR) << "cannot write cache entry: " << tmp_file_name;
+      return;
+    }
+    cereal::BinaryOutputArchive ar(os);
+    ar(key);
+    ar(is_satisfiable);
+    ar(model_counter);
+  }
+  if (std::rename(tmp_file_name.c_str(), file_name.c_str()) != 0) {
+    LOG(ERROR) << "cannot store cache entry: " << file_name;
+    std::remove(tmp_file_name.c_str());
+  }
+  DVLOG(VLOG_LEVEL) << "cache store: " << file_name;
+}
+
+std::string ModelCounterCache::get_file_name(const std::string& key) const {
+  char hash[17];
+  std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(Hash(key)));
+  return directory_ + "/" + hash + ".abc";
+}
+
+/**
+ * 64 bit FNV-1a, stable across runs and platforms
+ */
+std::uint64_t ModelCounterCache::Hash(const std::string& key) {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : key) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+} /* namespace Solver */
+} /* namespace Vlab */
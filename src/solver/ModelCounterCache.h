@@ -0,0 +1,80 @@
+/*
+ * ModelCounterCache.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SRC_SOLVER_MODELCOUNTERCACHE_H_
+#define SRC_SOLVER_MODELCOUNTERCACHE_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <glog/logging.h>
+
+#include "../cereal/archives/binary.hpp"
+#include "../cereal/types/string.hpp"
+#include "ModelCounter.h"
+
+namespace Vlab {
+namespace Solver {
+
+/**
+ * Content addressed on-disk cache of solving results. An entry keeps the
+ * satisfiability result and the model counter of a script under a file named
+ * after the hash of its normalized key (see CacheKeyGenerator); the full key is
+ * stored in the entry and compared on load to rule out hash collisions.
+ */
+class ModelCounterCache {
+ public:
+  ModelCounterCache(std::string directory);
+  virtual ~ModelCounterCache();
+
+  /**
+   * Loads the entry of the key if there is one
+   * @returns true if the entry exists
+   */
+  bool Load(const std::string& key, bool& is_satisfiable, ModelCounter& model_counter) const;
+
+  /**
+   * Stores an entry for the key, replaces an existing one
+   */
+  void Store(const std::string& key, const bool is_satisfiable, const ModelCounter& model_counter) const;
+
+ protected:
+  std::string get_file_name(const std::string& key) const;
+  static std::uint64_t Hash(const std::string& key);
+
+  /**
+   * Read only stream buffer over a memory mapped file
+   */
+  class MappedBuffer : public std::streambuf {
+   public:
+    MappedBuffer(char* data, std::size_t size) {
+      setg(data, data, data + size);
+    }
+  };
+
+  std::string directory_;
+ private:
+  static const int VLOG_LEVEL;
+};
+
+} /* namespace Solver */
+} /* namespace Vlab */
+
+#endif /* SRC_SOLVER_MODELCOUNTERCACHE_H_ */
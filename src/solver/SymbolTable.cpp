@@ -58,6 +58,10 @@ void SymbolTable::update_satisfiability_result(bool value) {
   global_assertion_result_ = global_assertion_result_ and value;
 }
 
+void SymbolTable::set_satisfiability_result(bool value) {
+  global_assertion_result_ = value;
+}
+
 /**
  * Removes let scope and all its data
  */
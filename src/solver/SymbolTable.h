@@ -49,6 +49,7 @@ public:
 
   bool isSatisfiable();
   void update_satisfiability_result(bool value);
+  void set_satisfiability_result(bool value);
   void clearLetScopes();
 
   void add_variable(SMT::Variable_ptr);
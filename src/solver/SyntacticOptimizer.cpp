@@ -12,7 +12,7 @@ namespace Solver {
 
 using namespace SMT;
 
-unsigned SyntacticOptimizer::name_counter = 0;
+std::atomic<unsigned> SyntacticOptimizer::name_counter {0};
 const int SyntacticOptimizer::VLOG_LEVEL = 18;
 
 SyntacticOptimizer::SyntacticOptimizer(Script_ptr script, SymbolTable_ptr symbol_table)
@@ -29,6 +29,10 @@ void SyntacticOptimizer::start() {
   end();
 }
 
+void SyntacticOptimizer::start(Term_ptr& term) {
+  visit_and_callback(term);
+}
+
 void SyntacticOptimizer::end() {
   DVLOG(VLOG_LEVEL) << "SyntacticOptimizer is finished!";
 
@@ -121,6 +125,8 @@ void SyntacticOptimizer::visitOr(Or_ptr or_term) {
         term = child_term;
       };
     }
+  } else {
+    check_and_process_string_dictionary(or_term);
   }
 
   DVLOG(VLOG_LEVEL) << "visit children end: " << *or_term << "@" << or_term;
@@ -2226,6 +2232,55 @@ Let_ptr SyntacticOptimizer::generateLetTermFor(LastIndexOf_ptr last_index_of_ter
   return let_term;
 }
 
+/**
+ * Transforms (or (= x "a") (= x "b") ...) into (in x "(a|b|...)"), the regex is a union of
+ * constants and is built as a single acyclic automaton
+ */
+bool SyntacticOptimizer::check_and_process_string_dictionary(Or_ptr or_term) {
+  std::string var_name;
+  std::vector<std::string> strings;
+  for (auto term : *(or_term->term_list)) {
+    Eq_ptr eq_term = dynamic_cast<Eq_ptr>(term);
+    if (eq_term == nullptr) {
+      return false;
+    }
+    QualIdentifier_ptr qi_term = dynamic_cast<QualIdentifier_ptr>(eq_term->left_term);
+    TermConstant_ptr term_constant = dynamic_cast<TermConstant_ptr>(eq_term->right_term);
+    if (qi_term == nullptr or term_constant == nullptr) {
+      qi_term = dynamic_cast<QualIdentifier_ptr>(eq_term->right_term);
+      term_constant = dynamic_cast<TermConstant_ptr>(eq_term->left_term);
+    }
+    if (qi_term == nullptr or term_constant == nullptr or Primitive::Type::STRING not_eq term_constant->getValueType()) {
+      return false;
+    }
+    if (var_name.empty()) {
+      var_name = qi_term->getVarName();
+    } else if (var_name not_eq qi_term->getVarName()) {
+      return false;
+    }
+    strings.push_back(term_constant->getValue());
+  }
+
+  std::stringstream regex;
+  regex << '(';
+  for (auto iter = strings.begin(); iter != strings.end(); ++iter) {
+    if (iter != strings.begin()) {
+      regex << '|';
+    }
+    regex << (iter->empty() ? "()" : Util::RegularExpression::escape_raw_string(*iter));
+  }
+  regex << ')';
+
+  DVLOG(VLOG_LEVEL) << "Transforming operation: disjunction of " << strings.size() << " string equalities on '" << var_name << "' into 'in'";
+  auto regex_term_constant = generate_term_constant(regex.str(), Primitive::Type::REGEX);
+  auto qi_term = generate_qual_identifier(var_name);
+  callback_ = [or_term, qi_term, regex_term_constant](Term_ptr & term) mutable {
+    term = new In(qi_term, regex_term_constant);
+    delete or_term;
+  };
+  return true;
+}
+
 Term_ptr SyntacticOptimizer::generate_term_constant(std::string data, Primitive::Type type) {
   return new TermConstant(new Primitive(data, type));
 }
@@ -9,6 +9,7 @@
 #define SOLVER_SYNTACTICOPTIMIZER_H_
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <functional>
 #include <initializer_list>
@@ -43,6 +44,7 @@ public:
   virtual ~SyntacticOptimizer();
 
   void start() override;
+  void start(SMT::Term_ptr& term);
   void end() override;
 
   void visitScript(SMT::Script_ptr) override;
@@ -127,6 +129,7 @@ protected:
   SMT::Let_ptr generateLetTermFor(SMT::IndexOf_ptr index_of_term, SMT::SubString::Mode local_substring_mode, SMT::LastIndexOf_ptr param_last_index_of_term, SMT::Term_ptr &index_term);
   SMT::Let_ptr generateLetTermFor(SMT::LastIndexOf_ptr index_of_term, SMT::SubString::Mode local_substring_mode, SMT::IndexOf_ptr param_index_of_term, SMT::Term_ptr &index_term);
   SMT::Let_ptr generateLetTermFor(SMT::LastIndexOf_ptr index_of_term, SMT::SubString::Mode local_substring_mode, SMT::LastIndexOf_ptr param_last_index_of_term, SMT::Term_ptr &index_term);
+  bool check_and_process_string_dictionary(SMT::Or_ptr or_term);
   SMT::Term_ptr generate_term_constant(std::string data, SMT::Primitive::Type type);
   void add_callback_to_replace_with_bool(SMT::Term_ptr, bool value);
   bool check_bool_constant_value(SMT::Term_ptr, std::string value);
@@ -139,7 +142,7 @@ protected:
   SMT::Script_ptr root_;
   SymbolTable_ptr symbol_table_;
   std::function<void(SMT::Term_ptr&)> callback_;
-  static unsigned name_counter;
+  static std::atomic<unsigned> name_counter;
 private:
   static const int VLOG_LEVEL;
 };
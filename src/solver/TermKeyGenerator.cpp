@@ -0,0 +1,102 @@
+/*
+ * TermKeyGenerator.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "TermKeyGenerator.h"
+
+namespace Vlab {
+namespace Solver {
+
+using namespace SMT;
+
+const int TermKeyGenerator::VLOG_LEVEL = 20;
+
+TermKeyGenerator::TermKeyGenerator(Term_ptr term)
+    : AstTraverser(nullptr),
+      term_(term),
+      is_memoizable_(true) {
+  setCallbacks();
+}
+
+TermKeyGenerator::~TermKeyGenerator() {
+}
+
+void TermKeyGenerator::start() {
+  key_.str("");
+  terms_.clear();
+  is_memoizable_ = true;
+  visit(term_);
+  end();
+}
+
+void TermKeyGenerator::end() {
+  DVLOG(VLOG_LEVEL) << "term key: " << key_.str() << (is_memoizable_ ? "" : " (not memoizable)");
+}
+
+void TermKeyGenerator::setCallbacks() {
+  auto term_pre_callback = [this] (Term_ptr term) -> bool {
+    terms_.push_back(term);
+    key_ << "(" << static_cast<int>(term->type());
+    switch (term->type()) {
+      case Term::Type::INDEXOF:
+        key_ << ":" << static_cast<int>(dynamic_cast<IndexOf_ptr>(term)->getMode());
+        break;
+      case Term::Type::LASTINDEXOF:
+        key_ << ":" << static_cast<int>(dynamic_cast<LastIndexOf_ptr>(term)->getMode());
+        break;
+      case Term::Type::SUBSTRING:
+        key_ << ":" << static_cast<int>(dynamic_cast<SubString_ptr>(term)->getMode());
+        break;
+      case Term::Type::CONCAT:
+      case Term::Type::LEN:
+      case Term::Type::CHARAT:
+      case Term::Type::TOUPPER:
+      case Term::Type::TOLOWER:
+      case Term::Type::TRIM:
+      case Term::Type::TOSTRING:
+      case Term::Type::TOINT:
+      case Term::Type::REPLACE:
+      case Term::Type::QUALIDENTIFIER:
+      case Term::Type::TERMCONSTANT:
+        break;
+      default:
+        is_memoizable_ = false;
+        break;
+    }
+    return is_memoizable_;
+  };
+
+  auto term_post_callback = [this] (Term_ptr) -> bool {
+    key_ << ")";
+    return true;
+  };
+
+  setTermPreCallback(term_pre_callback);
+  setTermPostCallback(term_post_callback);
+}
+
+void TermKeyGenerator::visitPrimitive(Primitive_ptr primitive) {
+  key_ << " " << static_cast<int>(primitive->getType()) << ":" << primitive->getData().size() << ":"
+       << primitive->getData();
+}
+
+bool TermKeyGenerator::is_memoizable() const {
+  return is_memoizable_;
+}
+
+std::string TermKeyGenerator::get_key() const {
+  return key_.str();
+}
+
+const std::vector<Term_ptr>& TermKeyGenerator::get_terms() const {
+  return terms_;
+}
+
+} /* namespace Solver */
+} /* namespace Vlab */
@@ -0,0 +1,65 @@
+/*
+ * TermKeyGenerator.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SRC_SOLVER_TERMKEYGENERATOR_H_
+#define SRC_SOLVER_TERMKEYGENERATOR_H_
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include "../smt/ast.h"
+#include "../smt/typedefs.h"
+#include "../smt/Visitor.h"
+#include "AstTraverser.h"
+
+namespace Vlab {
+namespace Solver {
+
+/**
+ * Generates the textual key of a single term, structurally equal terms share a key.
+ * Unlike CacheKeyGenerator symbols keep their names, the key identifies the value of a term
+ * under the current variable values. A term is memoizable if it is built only from string
+ * functions (concat, len, indexof, substring, replace, ...), variables and constants, i.e.
+ * the constraint solver computes its value from the values of its sub terms alone.
+ */
+class TermKeyGenerator : public AstTraverser {
+ public:
+  TermKeyGenerator(SMT::Term_ptr);
+  virtual ~TermKeyGenerator();
+  void start() override;
+  void end() override;
+  void setCallbacks();
+
+  void visitPrimitive(SMT::Primitive_ptr) override;
+
+  bool is_memoizable() const;
+  std::string get_key() const;
+
+  /**
+   * @returns sub terms in pre-order, the term itself first
+   */
+  const std::vector<SMT::Term_ptr>& get_terms() const;
+
+ protected:
+  SMT::Term_ptr term_;
+  bool is_memoizable_;
+  std::stringstream key_;
+  std::vector<SMT::Term_ptr> terms_;
+ private:
+  static const int VLOG_LEVEL;
+};
+
+} /* namespace Solver */
+} /* namespace Vlab */
+
+#endif /* SRC_SOLVER_TERMKEYGENERATOR_H_ */
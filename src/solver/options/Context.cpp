@@ -0,0 +1,88 @@
+/*
+ * Context.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "Context.h"
+
+#include "Solver.h"
+#include "../../theory/BoolAutomaton.h"
+#include "../../theory/IntAutomaton.h"
+#include "../../theory/options/Theory.h"
+#include "../../theory/StringAutomaton.h"
+#include "../../utils/RegularExpression.h"
+
+namespace Vlab {
+namespace Option {
+
+Context::Context()
+    : use_signed_integers_ { Solver::USE_SIGNED_INTEGERS },
+      use_multitrack_auto_ { Solver::USE_MULTITRACK_AUTO },
+      enable_equivalence_classes_ { Solver::ENABLE_EQUIVALENCE_CLASSES },
+      enable_dependency_analysis_ { Solver::ENABLE_DEPENDENCY_ANALYSIS },
+      enable_implications_ { Solver::ENABLE_IMPLICATIONS },
+      enable_len_implications_ { Solver::ENABLE_LEN_IMPLICATIONS },
+      enable_sorting_heuristics_ { Solver::ENABLE_SORTING_HEURISTICS },
+      num_threads_ { Solver::NUM_THREADS },
+      solver_output_path_ { Solver::OUTPUT_PATH },
+      solver_script_path_ { Solver::SCRIPT_PATH },
+      solver_cache_path_ { Solver::CACHE_PATH },
+      theory_tmp_path_ { Theory::TMP_PATH },
+      theory_script_path_ { Theory::SCRIPT_PATH },
+      use_interval_dfa_ { Theory::USE_INTERVAL_DFA },
+      theory_num_threads_ { Theory::NUM_THREADS },
+      regex_flags_ { Util::RegularExpression::DEFAULT },
+      string_num_of_variables_ { Vlab::Theory::StringAutomaton::DEFAULT_NUM_OF_VARIABLES },
+      int_num_of_variables_ { Vlab::Theory::IntAutomaton::DEFAULT_NUM_OF_VARIABLES },
+      bool_num_of_variables_ { Vlab::Theory::BoolAutomaton::DEFAULT_NUM_OF_VARIABLES } {
+}
+
+Context::~Context() {
+}
+
+Context Context::Current() {
+  return Context();
+}
+
+void Context::Install() const {
+  Solver::USE_SIGNED_INTEGERS = use_signed_integers_;
+  Solver::USE_MULTITRACK_AUTO = use_multitrack_auto_;
+  Solver::ENABLE_EQUIVALENCE_CLASSES = enable_equivalence_classes_;
+  Solver::ENABLE_DEPENDENCY_ANALYSIS = enable_dependency_analysis_;
+  Solver::ENABLE_IMPLICATIONS = enable_implications_;
+  Solver::ENABLE_LEN_IMPLICATIONS = enable_len_implications_;
+  Solver::ENABLE_SORTING_HEURISTICS = enable_sorting_heuristics_;
+  Solver::NUM_THREADS = num_threads_;
+  Solver::OUTPUT_PATH = solver_output_path_;
+  Solver::SCRIPT_PATH = solver_script_path_;
+  Solver::CACHE_PATH = solver_cache_path_;
+  Theory::TMP_PATH = theory_tmp_path_;
+  Theory::SCRIPT_PATH = theory_script_path_;
+  Theory::USE_INTERVAL_DFA = use_interval_dfa_;
+  Theory::NUM_THREADS = theory_num_threads_;
+  Util::RegularExpression::DEFAULT = regex_flags_;
+  Vlab::Theory::StringAutomaton::DEFAULT_NUM_OF_VARIABLES = string_num_of_variables_;
+  Vlab::Theory::IntAutomaton::DEFAULT_NUM_OF_VARIABLES = int_num_of_variables_;
+  Vlab::Theory::BoolAutomaton::DEFAULT_NUM_OF_VARIABLES = bool_num_of_variables_;
+}
+
+std::recursive_mutex& Context::automata_mutex() {
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+
+Context::Scope::Scope(const Context& context) : previous_ { Context::Current() } {
+  context.Install();
+}
+
+Context::Scope::~Scope() {
+  previous_.Install();
+}
+
+} /* namespace Option */
+} /* namespace Vlab */
@@ -0,0 +1,90 @@
+/*
+ * Context.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SRC_OPTIONS_CONTEXT_H_
+#define SRC_OPTIONS_CONTEXT_H_
+
+#include <mutex>
+#include <string>
+
+namespace Vlab {
+namespace Option {
+
+/**
+ * Snapshot of all solver options. Options are read through thread local statics
+ * (Option::Solver, Option::Theory, Util::RegularExpression::DEFAULT and the default number of
+ * variables of the string, int and bool automata); each driver keeps
+ * its own context and installs it on the calling thread for the duration of a call,
+ * so that several drivers can run on several threads with different options.
+ */
+class Context {
+ public:
+  Context();
+  Context(const Context&) = default;
+  Context& operator=(const Context&) = default;
+  ~Context();
+
+  /**
+   * @returns options currently installed on the calling thread
+   */
+  static Context Current();
+
+  /**
+   * Copies the options into the calling thread
+   */
+  void Install() const;
+
+  /**
+   * MONA keeps dfa builder (dfaSetup/dfaStoreException/dfaBuild) and bdd apply state in globals,
+   * any code constructing or freeing automata must hold that lock when drivers run concurrently.
+   * Drivers only run in parallel outside of automata construction (parsing, option handling,
+   * counting from cached counters) until the builder state is moved out of MONA's globals.
+   */
+  static std::recursive_mutex& automata_mutex();
+
+  class Scope;
+
+ protected:
+  bool use_signed_integers_;
+  bool use_multitrack_auto_;
+  bool enable_equivalence_classes_;
+  bool enable_dependency_analysis_;
+  bool enable_implications_;
+  bool enable_len_implications_;
+  bool enable_sorting_heuristics_;
+  int num_threads_;
+  std::string solver_output_path_;
+  std::string solver_script_path_;
+  std::string solver_cache_path_;
+  std::string theory_tmp_path_;
+  std::string theory_script_path_;
+  bool use_interval_dfa_;
+  int theory_num_threads_;
+  int regex_flags_;
+  int string_num_of_variables_;
+  int int_num_of_variables_;
+  int bool_num_of_variables_;
+};
+
+/**
+ * Installs a context for the lifetime of the scope and restores the previous one afterwards
+ */
+class Context::Scope {
+ public:
+  Scope(const Context& context);
+  ~Scope();
+ private:
+  Context previous_;
+};
+
+} /* namespace Option */
+} /* namespace Vlab */
+
+#endif /* SRC_OPTIONS_CONTEXT_H_ */
@@ -13,15 +13,17 @@
 namespace Vlab {
 namespace Option {
 
-bool Solver::USE_SIGNED_INTEGERS = true;
-bool Solver::USE_MULTITRACK_AUTO = true;
-bool Solver::ENABLE_EQUIVALENCE_CLASSES = true;
-bool Solver::ENABLE_DEPENDENCY_ANALYSIS = true;
-bool Solver::ENABLE_IMPLICATIONS = true;
-bool Solver::ENABLE_LEN_IMPLICATIONS = true;
-bool Solver::ENABLE_SORTING_HEURISTICS = true;
+thread_local bool Solver::USE_SIGNED_INTEGERS = true;
+thread_local bool Solver::USE_MULTITRACK_AUTO = true;
+thread_local bool Solver::ENABLE_EQUIVALENCE_CLASSES = true;
+thread_local bool Solver::ENABLE_DEPENDENCY_ANALYSIS = true;
+thread_local bool Solver::ENABLE_IMPLICATIONS = true;
+thread_local bool Solver::ENABLE_LEN_IMPLICATIONS = true;
+thread_local bool Solver::ENABLE_SORTING_HEURISTICS = true;
+thread_local int Solver::NUM_THREADS = 1;
 
-std::string Solver::OUTPUT_PATH         = ".";
-std::string Solver::SCRIPT_PATH         = ".";
+thread_local std::string Solver::OUTPUT_PATH         = ".";
+thread_local std::string Solver::SCRIPT_PATH         = ".";
+thread_local std::string Solver::CACHE_PATH          = "";
 } /* namespace Option */
 } /* namespace Vlab */
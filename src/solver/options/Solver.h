@@ -32,20 +32,35 @@ enum class Name: int {
   DISABLE_SORTING_HEURISTICS,
   REGEX_FLAG,
   OUTPUT_PATH,
-  SCRIPT_PATH
+  SCRIPT_PATH,
+  NUM_THREADS,
+  CACHE_PATH,
+  ENABLE_INTERVAL_DFA,
+  DISABLE_INTERVAL_DFA
 };
 
+/**
+ * Options are kept per thread, a driver installs its own values (see Context)
+ */
 class Solver {
 public:
-  static bool USE_SIGNED_INTEGERS;
-  static bool USE_MULTITRACK_AUTO;
-  static bool ENABLE_EQUIVALENCE_CLASSES;
-  static bool ENABLE_DEPENDENCY_ANALYSIS;
-  static bool ENABLE_IMPLICATIONS;
-  static bool ENABLE_LEN_IMPLICATIONS;
-  static bool ENABLE_SORTING_HEURISTICS;
-  static std::string OUTPUT_PATH;
-  static std::string SCRIPT_PATH;
+  static thread_local bool USE_SIGNED_INTEGERS;
+  static thread_local bool USE_MULTITRACK_AUTO;
+  static thread_local bool ENABLE_EQUIVALENCE_CLASSES;
+  static thread_local bool ENABLE_DEPENDENCY_ANALYSIS;
+  static thread_local bool ENABLE_IMPLICATIONS;
+  static thread_local bool ENABLE_LEN_IMPLICATIONS;
+  static thread_local bool ENABLE_SORTING_HEURISTICS;
+  /**
+   * Number of threads used to count independent components
+   */
+  static thread_local int NUM_THREADS;
+  static thread_local std::string OUTPUT_PATH;
+  static thread_local std::string SCRIPT_PATH;
+  /**
+   * Directory of the on-disk result cache, caching is disabled when empty
+   */
+  static thread_local std::string CACHE_PATH;
 };
 
 } /* namespace Option */
@@ -7,14 +7,20 @@
 
 #include "Automaton.h"
 
+#include "../solver/options/Context.h"
+
 namespace Vlab {
 namespace Theory {
 
 const int Automaton::VLOG_LEVEL = 9;
 
-int Automaton::name_counter = 0;
+const int Automaton::PARALLEL_COUNTER_MIN_STATES = 4096;
+
+std::atomic<int> Automaton::name_counter {0};
+std::unordered_map<DFA_ptr, int> Automaton::dfa_reference_counts;
+std::mutex Automaton::dfa_reference_counts_mutex;
 
-unsigned long Automaton::trace_id = 0;
+std::atomic<unsigned long> Automaton::trace_id {0};
 
 const std::string Automaton::Name::NONE = "none";
 const std::string Automaton::Name::BOOL = "BoolAutomaton";
@@ -24,25 +30,26 @@ const std::string Automaton::Name::STRING = "StringAutomaton";
 const std::string Automaton::Name::BINARYINT = "BinaryIntAutomaton";
 
 Automaton::Automaton(Automaton::Type type)
-        : type_(type), is_counter_cached_{false}, dfa_(nullptr), num_of_variables_(0), variable_indices_(nullptr), id_(Automaton::trace_id++) {
+        : type_(type), is_counter_cached_{false}, transition_graph_(nullptr), dfa_(nullptr), num_of_variables_(0), variable_indices_(nullptr), id_(Automaton::trace_id++) {
 }
 
 Automaton::Automaton(Automaton::Type type, DFA_ptr dfa, int num_of_variables)
-        : type_(type), is_counter_cached_{false}, dfa_(dfa), num_of_variables_(num_of_variables), id_(Automaton::trace_id++) {
+        : type_(type), is_counter_cached_{false}, transition_graph_(nullptr), dfa_(dfa), num_of_variables_(num_of_variables), id_(Automaton::trace_id++) {
   variable_indices_ = getIndices(num_of_variables, 1); // make indices one more to be safe
 }
 
 Automaton::Automaton(const Automaton& other)
-        : type_(other.type_), is_counter_cached_{false}, dfa_(nullptr), num_of_variables_(other.num_of_variables_), id_(Automaton::trace_id++) {
+        : type_(other.type_), is_counter_cached_{false}, transition_graph_(nullptr), dfa_(other.dfa_), num_of_variables_(other.num_of_variables_), id_(Automaton::trace_id++) {
           if (other.dfa_) {
-            dfa_ = dfaCopy(other.dfa_);
+            AddDFAReference(dfa_);
           }
           variable_indices_ = getIndices(num_of_variables_, 1); // make indices one more to be safe
 }
 
 Automaton::~Automaton() {
+  ClearTransitionGraph();
   if (dfa_) {
-    dfaFree(dfa_);
+    ReleaseDFA(dfa_);
     dfa_ = nullptr;
   }
   delete[] variable_indices_;
@@ -94,26 +101,27 @@ int* Automaton::getVariableIndices() {
   return variable_indices_;
 }
 
-/**
- * TODO write test cases
- */
 bool Automaton::IsEqual(Automaton_ptr other_auto) {
+  return not FindDistinguishingWord(other_auto, false, nullptr);
+}
 
-  auto impl_1 = dfaProduct(this->dfa_, other_auto->dfa_, dfaIMPL);
-  auto impl_2 = dfaProduct(other_auto->dfa_, this->dfa_, dfaIMPL);
-  auto result_dfa = dfaProduct(impl_1,impl_2,dfaAND);
-  dfaFree(impl_1);
-  dfaFree(impl_2);
-
-  dfaNegation(result_dfa);
-
-  auto minimized_dfa = dfaMinimize(result_dfa);
-  dfaFree(result_dfa);
+/**
+ * @param counter_example is set to a word accepted by only one of the automata when they differ,
+ * each symbol is given with its bits in variable index order
+ */
+bool Automaton::IsEqual(Automaton_ptr other_auto, std::vector<std::vector<char>>& counter_example) {
+  return not FindDistinguishingWord(other_auto, false, &counter_example);
+}
 
-  bool is_empty_language = (minimized_dfa->ns == 1 && minimized_dfa->f[minimized_dfa->s] == -1)? true : false;
-  dfaFree(minimized_dfa);
+bool Automaton::IsSubsetOf(Automaton_ptr other_auto) {
+  return not FindDistinguishingWord(other_auto, true, nullptr);
+}
 
-  return is_empty_language;
+/**
+ * @param counter_example is set to a word accepted by this automaton but not the other one
+ */
+bool Automaton::IsSubsetOf(Automaton_ptr other_auto, std::vector<std::vector<char>>& counter_example) {
+  return not FindDistinguishingWord(other_auto, true, &counter_example);
 }
 
 /**
@@ -146,25 +154,20 @@ bool Automaton::isOnlyInitialStateAccepting() {
 }
 
 bool Automaton::isCyclic() {
-  bool result = false;
-  std::map<int, bool> is_discovered;
-  std::map<int, bool> is_stack_member;
-  int sink_state = GetSinkState();
-  is_discovered[sink_state] = true; // avoid sink state
-
-  result = isCyclic(this->dfa_->s, is_discovered, is_stack_member);
+  bool result = GetTransitionGraph()->HasCycle(this->dfa_->s);
   DVLOG(VLOG_LEVEL) << "[" << this->id_ << "]->isCyclic() ? " << std::boolalpha << result;
   return result;
 }
 
 bool Automaton::isInCycle(int state) {
-  std::map<int, bool> is_stack_member;
-  return isStateReachableFrom(state, state, is_stack_member);
+  return isStateReachableFrom(state, state);
 }
 
+/**
+ * Paths through the sink state are not considered
+ */
 bool Automaton::isStateReachableFrom(int search_state, int from_state) {
-  std::map<int, bool> is_stack_member;
-  return isStateReachableFrom(search_state, from_state, is_stack_member);
+  return GetTransitionGraph()->IsReachable(from_state, search_state);
 }
 
 BigInteger Automaton::Count(const unsigned long bound) {
@@ -198,61 +201,28 @@ BigInteger Automaton::CountByMatrixMultiplication(unsigned long bound) {
   return result;
 }
 
+/**
+ * Counts with the linear recurrence of the count sequence (no external tool needed)
+ */
 BigInteger Automaton::SymbolicCount(int bound, bool count_less_than_or_equal_to_bound) {
-  std::stringstream cmd;
-  std::string str_result;
-  std::string tmp_math_file = Option::Theory::TMP_PATH + "/math_script.m";
-  std::ofstream out_file(tmp_math_file.c_str());
+  if (not is_counter_cached_) {
+    SetSymbolicCounter();
+  }
 
-  generateMatrixScript(bound, out_file, count_less_than_or_equal_to_bound);
-//  generateGFScript(bound, out_file, count_less_than_or_equal_to_bound);
-  cmd << "math -script " << tmp_math_file;
-  try {
-    DVLOG(VLOG_LEVEL) << "run_cmd(`" << cmd.str() << "`)";
-    str_result = Util::Cmd::run_cmd(cmd.str());
-  } catch (std::string& e) {
-    LOG(ERROR) << e;
+  BigInteger result = counter_.CountbyRecurrence(bound);
+  // string counter counts all lengths up to bound, subtract the shorter ones for an exact count
+  if ((not count_less_than_or_equal_to_bound) and SymbolicCounter::Type::STRING == counter_.type() and bound > 0) {
+    result -= counter_.CountbyRecurrence(bound - 1);
   }
 
-  return BigInteger (str_result);
+  DVLOG(VLOG_LEVEL) << "[" << this->id_ << "]->SymbolicCount(" << bound << ") : " << result;
+  return result;
 }
 
 BigInteger Automaton::SymbolicCount(double bound, bool count_less_than_or_equal_to_bound) {
   return SymbolicCount(static_cast<int>(bound), count_less_than_or_equal_to_bound);
 }
 
-bool Automaton::isCyclic(int state, std::map<int, bool>& is_discovered, std::map<int, bool>& is_stack_member) {
-  if (not is_discovered[state]) {
-    is_discovered[state] = true;
-    is_stack_member[state] = true;
-    for (auto next_state : getNextStates(state)) {
-      if ((not is_discovered[next_state]) and isCyclic(next_state, is_discovered, is_stack_member)) {
-        return true;
-      } else if (is_stack_member[next_state]) {
-        return true;
-      }
-    }
-  }
-  is_stack_member[state] = false;
-  return false;
-}
-
-bool Automaton::isStateReachableFrom(int search_state, int from_state, std::map<int, bool>& is_stack_member) {
-  is_stack_member[from_state] = true;
-
-  for (auto next_state : getNextStates(from_state)) {
-    if (next_state == search_state) {
-      return true;
-    } else if ((not is_stack_member[next_state]) and (not isSinkState(next_state)) and
-      isStateReachableFrom(search_state, next_state, is_stack_member)) {
-      return true;
-    }
-  }
-
-  is_stack_member[from_state] = false;
-  return false;
-}
-
 /**
  * @returns graph representation of automaton
  */
@@ -274,10 +244,22 @@ Graph_ptr Automaton::toGraph() {
     }
   }
   node = nullptr;
+  // transition graph leaves out the sink, a state has an edge to it when its edges do not cover all symbols
+  TransitionGraph_ptr transition_graph = GetTransitionGraph();
+  const int sink_state = GetSinkState();
+  const TransitionGraph::BigInteger num_of_symbols = TransitionGraph::BigInteger(1) << num_of_variables_;
   for (auto& entry : graph->getNodeMap()) {
     node = entry.second;
-    for (int id : getNextStates(node->getID())) {
-      next_node = graph->getNode(id);
+    const int s = node->getID();
+    TransitionGraph::BigInteger num_of_covered_symbols = 0;
+    for (int edge = transition_graph->get_offset(s); edge < transition_graph->get_offset(s + 1); ++edge) {
+      next_node = graph->getNode(transition_graph->get_target(edge));
+      node->addNextNode(next_node);
+      next_node->addPrevNode(node);
+      num_of_covered_symbols += transition_graph->get_multiplicity(edge);
+    }
+    if (sink_state != -1 and num_of_covered_symbols < num_of_symbols) {
+      next_node = graph->getNode(sink_state);
       node->addNextNode(next_node);
       next_node->addPrevNode(node);
     }
@@ -286,6 +268,183 @@ Graph_ptr Automaton::toGraph() {
   return graph;
 }
 
+/**
+ * Extracts the successor graph once and keeps it until the dfa changes, transitions to the sink
+ * state are left out and the number of symbols on each edge is kept as its multiplicity
+ */
+TransitionGraph_ptr Automaton::GetTransitionGraph() {
+  if (transition_graph_ != nullptr) {
+    return transition_graph_;
+  }
+
+  transition_graph_ = new TransitionGraph();
+  const int sink_state = GetSinkState();
+  const auto index_levels = GetBddIndexLevels();
+  std::unordered_map<unsigned, std::map<int, BigInteger>> successor_counts;
+  for (int s = 0; s < this->dfa_->ns; ++s) {
+    transition_graph_->AddNode();
+    if (sink_state != s) {
+      std::map<int, BigInteger> counts;
+      AddSuccessorCounts(this->dfa_->q[s], 0, sink_state, index_levels, successor_counts, counts);
+      for (auto& successor : counts) {
+        transition_graph_->AddEdge(successor.first, successor.second);
+      }
+    }
+  }
+
+  DVLOG(VLOG_LEVEL) << "[" << this->id_ << "]->GetTransitionGraph() has " << transition_graph_->num_of_edges() << " edges";
+  return transition_graph_;
+}
+
+void Automaton::DetachDFA() {
+  std::lock_guard<std::mutex> lock(dfa_reference_counts_mutex);
+  auto it = dfa_reference_counts.find(dfa_);
+  if (it == dfa_reference_counts.end()) {
+    return;
+  }
+  if (--it->second == 0) {
+    dfa_reference_counts.erase(it);
+  }
+  ClearTransitionGraph();
+  is_counter_cached_ = false;
+  dfa_ = dfaCopy(dfa_);
+}
+
+/**
+ * Counts the automata that share a dfa besides its first owner
+ */
+void Automaton::AddDFAReference(DFA_ptr dfa) {
+  std::lock_guard<std::mutex> lock(dfa_reference_counts_mutex);
+  ++dfa_reference_counts[dfa];
+}
+
+void Automaton::ReleaseDFA(DFA_ptr dfa) {
+  {
+    std::lock_guard<std::mutex> lock(dfa_reference_counts_mutex);
+    auto it = dfa_reference_counts.find(dfa);
+    if (it != dfa_reference_counts.end()) {
+      if (--it->second == 0) {
+        dfa_reference_counts.erase(it);
+      }
+      return;
+    }
+  }
+  dfaFree(dfa);
+}
+
+void Automaton::ClearTransitionGraph() {
+  delete transition_graph_;
+  transition_graph_ = nullptr;
+}
+
+/**
+ * Explores state pairs of the two automata on the fly and stops at the first pair that
+ * distinguishes them. Equivalence merges the states of a visited pair with union-find
+ * (Hopcroft-Karp), so a pair is skipped once its states are known to be related;
+ * inclusion visits each pair once and only fails on a pair whose left state accepts alone.
+ * Successors are read by walking both bdds together. Pairs are explored breadth first, but skipped
+ * pairs may hide a shorter word, the word found is not necessarily a shortest one.
+ * @returns true if a distinguishing word is found, the word is written to 'word' if it is given
+ */
+bool Automaton::FindDistinguishingWord(Automaton_ptr other_auto, bool check_inclusion,
+                                       std::vector<std::vector<char>>* word) {
+  CHECK_EQ(num_of_variables_, other_auto->num_of_variables_)<< "automata must have the same alphabet";
+
+  struct StatePair {
+    int left;
+    int right;
+    int parent;
+    std::vector<char> symbol;
+  };
+
+  DFA_ptr left_dfa = this->dfa_, right_dfa = other_auto->dfa_;
+  const int right_offset = left_dfa->ns;
+  std::vector<int> representatives(left_dfa->ns + right_dfa->ns);
+  std::vector<int> ranks(representatives.size(), 0);
+  for (unsigned i = 0; i < representatives.size(); ++i) {
+    representatives[i] = i;
+  }
+  // path halving, every other state on the path points to its grandparent
+  auto find = [&representatives](int state) {
+    while (representatives[state] != state) {
+      representatives[state] = representatives[representatives[state]];
+      state = representatives[state];
+    }
+    return state;
+  };
+  std::set<std::pair<int, int>> visited_pairs;
+  // returns true if the pair needs to be explored
+  auto relate = [&](int left, int right) {
+    if (check_inclusion) {
+      return visited_pairs.insert(std::make_pair(left, right)).second;
+    }
+    int left_root = find(left), right_root = find(right + right_offset);
+    if (left_root == right_root) {
+      return false;
+    }
+    // union by rank
+    if (ranks[left_root] < ranks[right_root]) {
+      std::swap(left_root, right_root);
+    }
+    representatives[right_root] = left_root;
+    if (ranks[left_root] == ranks[right_root]) {
+      ++ranks[left_root];
+    }
+    return true;
+  };
+
+  std::vector<StatePair> state_pairs;
+  std::queue<int> work_list;
+  std::vector<char> symbol(num_of_variables_, '0');
+  std::function<void(int, unsigned, unsigned)> add_successors = [&](int pair_index, unsigned left_node, unsigned right_node) {
+    unsigned left_l, left_r, left_index, right_l, right_r, right_index;
+    LOAD_lri(&left_dfa->bddm->node_table[left_node], left_l, left_r, left_index);
+    LOAD_lri(&right_dfa->bddm->node_table[right_node], right_l, right_r, right_index);
+    if (left_index == BDD_LEAF_INDEX and right_index == BDD_LEAF_INDEX) {
+      if (relate(left_l, right_l)) {
+        state_pairs.push_back(StatePair {static_cast<int>(left_l), static_cast<int>(right_l), pair_index, symbol});
+        work_list.push(state_pairs.size() - 1);
+      }
+      return;
+    }
+
+    unsigned index = (left_index == BDD_LEAF_INDEX or (right_index != BDD_LEAF_INDEX and right_index < left_index)) ?
+        right_index : left_index;
+    symbol[index] = '0';
+    add_successors(pair_index, (left_index == index) ? left_l : left_node, (right_index == index) ? right_l : right_node);
+    symbol[index] = '1';
+    add_successors(pair_index, (left_index == index) ? left_r : left_node, (right_index == index) ? right_r : right_node);
+    symbol[index] = '0';
+  };
+
+  relate(left_dfa->s, right_dfa->s);
+  state_pairs.push_back(StatePair {left_dfa->s, right_dfa->s, -1, std::vector<char>()});
+  work_list.push(0);
+  while (not work_list.empty()) {
+    const int pair_index = work_list.front();
+    work_list.pop();
+    const bool is_left_accepting = (left_dfa->f[state_pairs[pair_index].left] == 1);
+    const bool is_right_accepting = (right_dfa->f[state_pairs[pair_index].right] == 1);
+    if ((is_left_accepting and not is_right_accepting) or ((not check_inclusion) and is_right_accepting and not is_left_accepting)) {
+      if (word != nullptr) {
+        word->clear();
+        for (int i = pair_index; state_pairs[i].parent != -1; i = state_pairs[i].parent) {
+          word->push_back(state_pairs[i].symbol);
+        }
+        std::reverse(word->begin(), word->end());
+      }
+      DVLOG(VLOG_LEVEL) << "[" << this->id_ << "] and [" << other_auto->id_ << "] are distinguished after exploring "
+                        << state_pairs.size() << " state pairs";
+      return true;
+    }
+    add_successors(pair_index, left_dfa->q[state_pairs[pair_index].left], right_dfa->q[state_pairs[pair_index].right]);
+  }
+
+  DVLOG(VLOG_LEVEL) << "[" << this->id_ << "] " << (check_inclusion ? "is included in" : "is equal to") << " ["
+                    << other_auto->id_ << "] after exploring " << state_pairs.size() << " state pairs";
+  return false;
+}
+
 /**
  * Assumes automaton is minimized and there is a sink state
  * @returns true if automaton is a singleton
@@ -463,6 +622,263 @@ DFA_ptr Automaton::DfaUnion(DFA_ptr dfa1, DFA_ptr dfa2) {
   return minimized_dfa;
 }
 
+DFA_ptr Automaton::DfaConcat(DFA_ptr prefix_dfa, DFA_ptr suffix_dfa, int num_of_variables, int* variable_indices) {
+  return DfaConcat(prefix_dfa, prefix_dfa->s, suffix_dfa, std::vector<int>(), num_of_variables, variable_indices);
+}
+
+/**
+ * {x | xy in subject for some y in suffix}, a subject state accepts if it reaches an accepting
+ * state together with an accepting suffix state from the suffix start state
+ */
+DFA_ptr Automaton::DfaRightQuotient(DFA_ptr subject_dfa, DFA_ptr suffix_dfa) {
+  std::map<std::pair<int, int>, int> pair_ids;
+  std::vector<std::pair<int, int>> pairs;
+  std::vector<std::vector<int>> predecessors;
+  auto get_pair_id = [&](int subject_state, int suffix_state) {
+    auto pair = std::make_pair(subject_state, suffix_state);
+    auto it = pair_ids.find(pair);
+    if (it != pair_ids.end()) {
+      return it->second;
+    }
+    int id = pairs.size();
+    pair_ids[pair] = id;
+    pairs.push_back(pair);
+    predecessors.push_back(std::vector<int>());
+    return id;
+  };
+
+  for (int s = 0; s < subject_dfa->ns; ++s) {
+    get_pair_id(s, suffix_dfa->s);
+  }
+  for (std::size_t current = 0; current < pairs.size(); ++current) {
+    const auto pair = pairs[current];
+    ForEachSuccessorPair(subject_dfa, subject_dfa->q[pair.first], suffix_dfa, suffix_dfa->q[pair.second],
+        [&](int subject_state, int suffix_state) {
+          predecessors[get_pair_id(subject_state, suffix_state)].push_back(current);
+        });
+  }
+
+  std::vector<bool> is_coreachable(pairs.size(), false);
+  std::vector<int> work_list;
+  for (std::size_t i = 0; i < pairs.size(); ++i) {
+    if (subject_dfa->f[pairs[i].first] == 1 and suffix_dfa->f[pairs[i].second] == 1) {
+      is_coreachable[i] = true;
+      work_list.push_back(i);
+    }
+  }
+  while (not work_list.empty()) {
+    int current = work_list.back();
+    work_list.pop_back();
+    for (int predecessor : predecessors[current]) {
+      if (not is_coreachable[predecessor]) {
+        is_coreachable[predecessor] = true;
+        work_list.push_back(predecessor);
+      }
+    }
+  }
+
+  DFA_ptr quotient_dfa = dfaCopy(subject_dfa);
+  for (int s = 0; s < quotient_dfa->ns; ++s) {
+    quotient_dfa->f[s] = is_coreachable[s] ? 1 : -1;  // pairs of the suffix start state are the first ns ids
+  }
+  DFA_ptr minimized_dfa = dfaMinimize(quotient_dfa);
+  dfaFree(quotient_dfa);
+  return minimized_dfa;
+}
+
+/**
+ * {y | xy in subject for some x in prefix}, the subject is determinized from the states it
+ * reaches together with an accepting prefix state
+ */
+DFA_ptr Automaton::DfaLeftQuotient(DFA_ptr subject_dfa, DFA_ptr prefix_dfa, int num_of_variables, int* variable_indices) {
+  std::set<std::pair<int, int>> visited_pairs {std::make_pair(subject_dfa->s, prefix_dfa->s)};
+  std::vector<std::pair<int, int>> work_list {std::make_pair(subject_dfa->s, prefix_dfa->s)};
+  std::vector<int> start_states;
+  while (not work_list.empty()) {
+    const auto pair = work_list.back();
+    work_list.pop_back();
+    if (prefix_dfa->f[pair.second] == 1) {
+      start_states.push_back(pair.first);
+    }
+    ForEachSuccessorPair(subject_dfa, subject_dfa->q[pair.first], prefix_dfa, prefix_dfa->q[pair.second],
+        [&](int subject_state, int prefix_state) {
+          if (visited_pairs.insert(std::make_pair(subject_state, prefix_state)).second) {
+            work_list.push_back(std::make_pair(subject_state, prefix_state));
+          }
+        });
+  }
+
+  return DfaConcat(nullptr, -1, subject_dfa, start_states, num_of_variables, variable_indices);
+}
+
+/**
+ * Calls back with each pair of states reached by a symbol from the two bdd nodes
+ */
+void Automaton::ForEachSuccessorPair(DFA_ptr dfa1, unsigned bdd_node1, DFA_ptr dfa2, unsigned bdd_node2,
+                                     const std::function<void(int, int)>& callback) {
+  unsigned l1, r1, index1, l2, r2, index2;
+  LOAD_lri(&dfa1->bddm->node_table[bdd_node1], l1, r1, index1);
+  LOAD_lri(&dfa2->bddm->node_table[bdd_node2], l2, r2, index2);
+  if (index1 == BDD_LEAF_INDEX and index2 == BDD_LEAF_INDEX) {
+    callback(l1, l2);
+    return;
+  }
+  unsigned index = (index1 == BDD_LEAF_INDEX or (index2 != BDD_LEAF_INDEX and index2 < index1)) ? index2 : index1;
+  ForEachSuccessorPair(dfa1, (index1 == index) ? l1 : bdd_node1, dfa2, (index2 == index) ? l2 : bdd_node2, callback);
+  ForEachSuccessorPair(dfa1, (index1 == index) ? r1 : bdd_node1, dfa2, (index2 == index) ? r2 : bdd_node2, callback);
+}
+
+/**
+ * Concatenation as a subset construction over (prefix state, set of suffix states) that steps
+ * all bdds of a macro state together; the suffix start state joins the set whenever the prefix
+ * state accepts, so the empty string needs no special handling.
+ * Without a prefix state (-1) it determinizes the suffix from the given states.
+ */
+DFA_ptr Automaton::DfaConcat(DFA_ptr prefix_dfa, int prefix_state, DFA_ptr suffix_dfa, std::vector<int> suffix_states,
+                             int num_of_variables, int* variable_indices) {
+  using MacroState = std::pair<int, std::vector<int>>;
+  using Transition = std::pair<std::vector<char>, int>;
+  const int prefix_sink = (prefix_dfa == nullptr) ? -1 : find_sink(prefix_dfa), suffix_sink = find_sink(suffix_dfa);
+  std::map<MacroState, int> macro_state_ids;
+  std::vector<MacroState> macro_states;
+
+  auto get_macro_state_id = [&](int prefix_state, std::vector<int> suffix_states) -> int {
+    if (prefix_state == prefix_sink) {
+      prefix_state = -1;
+    }
+    if (prefix_state != -1 and prefix_dfa->f[prefix_state] == 1) {
+      suffix_states.push_back(suffix_dfa->s);
+    }
+    suffix_states.erase(std::remove(suffix_states.begin(), suffix_states.end(), suffix_sink), suffix_states.end());
+    std::sort(suffix_states.begin(), suffix_states.end());
+    suffix_states.erase(std::unique(suffix_states.begin(), suffix_states.end()), suffix_states.end());
+    if (prefix_state == -1 and suffix_states.empty()) {
+      return -1;
+    }
+    MacroState macro_state {prefix_state, std::move(suffix_states)};
+    auto it = macro_state_ids.find(macro_state);
+    if (it != macro_state_ids.end()) {
+      return it->second;
+    }
+    int id = macro_states.size();
+    macro_state_ids[macro_state] = id;
+    macro_states.push_back(std::move(macro_state));
+    return id;
+  };
+
+  if (get_macro_state_id(prefix_state, std::move(suffix_states)) == -1) {
+    // DfaMakePhi frees the indices it is given, the caller still owns variable_indices
+    int* phi_indices = nullptr;
+    if (variable_indices != nullptr) {
+      phi_indices = new int[num_of_variables];
+      std::copy(variable_indices, variable_indices + num_of_variables, phi_indices);
+    }
+    return DfaMakePhi(num_of_variables, phi_indices);
+  }
+
+  // bdd nodes of the prefix state (if any) come first, bdd variable indices are positions in the path
+  std::vector<std::vector<Transition>> transitions;
+  std::vector<char> path(num_of_variables + 1, 'X');
+  path[num_of_variables] = '\0';
+  std::function<void(int, std::vector<unsigned>&, bool)> add_transitions =
+      [&](int macro_state_id, std::vector<unsigned>& bdd_nodes, bool has_prefix_state) {
+    unsigned l, r, index, min_index = BDD_LEAF_INDEX;
+    std::vector<int> leaf_states(bdd_nodes.size());
+    for (std::size_t i = 0; i < bdd_nodes.size(); ++i) {
+      DFA_ptr dfa = (has_prefix_state and i == 0) ? prefix_dfa : suffix_dfa;
+      LOAD_lri(&dfa->bddm->node_table[bdd_nodes[i]], l, r, index);
+      if (index == BDD_LEAF_INDEX) {
+        leaf_states[i] = l;
+      } else if (min_index == BDD_LEAF_INDEX or index < min_index) {
+        min_index = index;
+      }
+    }
+
+    if (min_index == BDD_LEAF_INDEX) {
+      int next_prefix_state = has_prefix_state ? leaf_states[0] : -1;
+      std::vector<int> next_suffix_states(leaf_states.begin() + (has_prefix_state ? 1 : 0), leaf_states.end());
+      int target = get_macro_state_id(next_prefix_state, std::move(next_suffix_states));
+      transitions[macro_state_id].push_back(std::make_pair(path, target));
+      return;
+    }
+
+    std::vector<unsigned> low_nodes = bdd_nodes, high_nodes = bdd_nodes;
+    for (std::size_t i = 0; i < bdd_nodes.size(); ++i) {
+      DFA_ptr dfa = (has_prefix_state and i == 0) ? prefix_dfa : suffix_dfa;
+      LOAD_lri(&dfa->bddm->node_table[bdd_nodes[i]], l, r, index);
+      if (index == min_index) {
+        low_nodes[i] = l;
+        high_nodes[i] = r;
+      }
+    }
+    path[min_index] = '0';
+    add_transitions(macro_state_id, low_nodes, has_prefix_state);
+    path[min_index] = '1';
+    add_transitions(macro_state_id, high_nodes, has_prefix_state);
+    path[min_index] = 'X';
+  };
+
+  std::vector<unsigned> bdd_nodes;
+  for (std::size_t current = 0; current < macro_states.size(); ++current) {
+    transitions.push_back(std::vector<Transition>());
+    const MacroState macro_state = macro_states[current];
+    bdd_nodes.clear();
+    if (macro_state.first != -1) {
+      bdd_nodes.push_back(prefix_dfa->q[macro_state.first]);
+    }
+    for (int suffix_state : macro_state.second) {
+      bdd_nodes.push_back(suffix_dfa->q[suffix_state]);
+    }
+    add_transitions(current, bdd_nodes, macro_state.first != -1);
+  }
+
+  // last state is the sink that takes transitions to the empty macro state
+  const int sink_state = macro_states.size();
+  const int number_of_states = sink_state + 1;
+  char* statuses = new char[number_of_states + 1];
+  std::map<int, int> target_frequencies;
+  dfaSetup(number_of_states, num_of_variables, variable_indices);
+  for (int s = 0; s < sink_state; ++s) {
+    target_frequencies.clear();
+    for (auto& transition : transitions[s]) {
+      if (transition.second == -1) {
+        transition.second = sink_state;
+      }
+      ++target_frequencies[transition.second];
+    }
+    auto default_target = std::max_element(target_frequencies.begin(), target_frequencies.end(),
+        [](const std::pair<const int, int>& left, const std::pair<const int, int>& right) {
+          return left.second < right.second;
+        })->first;
+
+    dfaAllocExceptions(transitions[s].size() - target_frequencies[default_target]);
+    for (auto& transition : transitions[s]) {
+      if (transition.second != default_target) {
+        dfaStoreException(transition.second, &*transition.first.begin());
+      }
+    }
+    dfaStoreState(default_target);
+
+    statuses[s] = '-';
+    for (int suffix_state : macro_states[s].second) {
+      if (suffix_dfa->f[suffix_state] == 1) {
+        statuses[s] = '+';
+        break;
+      }
+    }
+  }
+  dfaAllocExceptions(0);
+  dfaStoreState(sink_state);
+  statuses[sink_state] = '-';
+  statuses[number_of_states] = '\0';
+
+  DFA_ptr concat_dfa = dfaBuild(statuses);
+  delete[] statuses;
+  DFA_ptr minimized_dfa = dfaMinimize(concat_dfa);
+  dfaFree(concat_dfa);
+  return minimized_dfa;
+}
+
 DFA_ptr Automaton::DFAProjectAway(int index, DFA_ptr dfa) {
   auto result_dfa = dfaProject(dfa, (unsigned)index);
   auto tmp_dfa = result_dfa;
@@ -497,8 +913,7 @@ DFA_ptr Automaton::DfaL1ToL2(int start, int end, int num_of_variables, int *vari
     variable_indices = getIndices(num_of_variables);
   }
   if (start <= -1 && end <= -1) {
-    result = Automaton::DfaMakePhi(num_of_variables, variable_indices);
-    delete[] variable_indices;
+    result = Automaton::DfaMakePhi(num_of_variables, variable_indices);  // frees variable_indices
     return result;
   }
   if ( start <= -1 ) {
@@ -653,16 +1068,18 @@ std::vector<char> Automaton::getReservedWord(char last_char, int length, bool ex
 }
 
 void Automaton::minimize() {
+  ClearTransitionGraph();
   DFA_ptr tmp = this->dfa_;
   this->dfa_ = dfaMinimize(tmp);
-  dfaFree(tmp);
+  ReleaseDFA(tmp);
   DVLOG(VLOG_LEVEL) << this->id_ << " = [" << this->id_ << "]->minimize()";
 }
 
 void Automaton::project(unsigned index) {
+  ClearTransitionGraph();
   DFA_ptr tmp = this->dfa_;
   this->dfa_ = dfaProject(tmp, index);
-  dfaFree(tmp);
+  ReleaseDFA(tmp);
 
   if (index < (unsigned)(this->num_of_variables_ - 1)) {
     int* indices_map = new int[this->num_of_variables_];
@@ -896,72 +1313,58 @@ std::set<int> Automaton::getStatesReachableBy(int walk) {
 }
 
 std::set<int> Automaton::getStatesReachableBy(int min_walk, int max_walk) {
-  std::set<int> states;
-
-  std::stack<std::pair<int, int>> state_stack;
-  int sink_state = GetSinkState();
-  if (sink_state != this->dfa_->s) {
-    state_stack.push(std::make_pair(this->dfa_->s, 0));
+  if (isSinkState(this->dfa_->s)) {
+    return std::set<int>();
   }
-  while (not state_stack.empty()) {
-    auto current = state_stack.top(); state_stack.pop();
-
-    if (current.second >= min_walk and current.second <= max_walk) {
-      states.insert(current.first);
-    }
-
-    if (current.second < max_walk) {
-      for (auto next_state : getNextStates(current.first)) {
-        if (sink_state != next_state) {
-          state_stack.push(std::make_pair(next_state, current.second + 1));
-        }
-      }
-    }
-  }
-  return states;
+  auto states = GetTransitionGraph()->GetNodesReachableBy(this->dfa_->s, min_walk, max_walk);
+  return std::set<int>(states.begin(), states.end());
 }
 
+/**
+ * Rows of the count matrix come from memoized bdd node successor counts, large automata split
+ * the rows between Option::Theory::NUM_THREADS threads, each with its own memo
+ */
 void Automaton::SetSymbolicCounter() {
-  std::vector<Eigen::Triplet<BigInteger>> entries;
   const int sink_state = GetSinkState();
-  unsigned left, right, index;
-  for (int s = 0; s < this->dfa_->ns; ++s) {
-    if (sink_state != s) {
-      // Node is a pair<sbdd_node_id, bdd_depth>
-      Node current_bdd_node {dfa_->q[s], 0}, left_node, right_node;
-      std::stack<Node> bdd_node_stack;
-      bdd_node_stack.push(current_bdd_node);
-      while (not bdd_node_stack.empty()) {
-        current_bdd_node = bdd_node_stack.top(); bdd_node_stack.pop();
-        LOAD_lri(&dfa_->bddm->node_table[current_bdd_node.first], left, right, index);
-        if (index == BDD_LEAF_INDEX) {
-          if (sink_state != left) {
-            const int exponent = num_of_variables_ - current_bdd_node.second;
-            if (exponent == 0) {
-              entries.push_back(Eigen::Triplet<BigInteger>(s, left, 1));
-            } else if (exponent < 31) {
-              entries.push_back(Eigen::Triplet<BigInteger>(s, left, static_cast<int>(std::pow(2, exponent))));
-            } else {
-              entries.push_back(Eigen::Triplet<BigInteger>(s, left, boost::multiprecision::pow(boost::multiprecision::cpp_int(2), exponent)));
-            }
-          }
-        } else {
-          left_node.first = left;
-          left_node.second = current_bdd_node.second + 1;
-          right_node.first = right;
-          right_node.second = current_bdd_node.second + 1;
-          bdd_node_stack.push(left_node);
-          bdd_node_stack.push(right_node);
-        }
+  const int num_of_states = this->dfa_->ns;
+  const int num_of_threads = (num_of_states < PARALLEL_COUNTER_MIN_STATES) ? 1 : std::max(1, Option::Theory::NUM_THREADS);
+  std::vector<std::vector<Eigen::Triplet<BigInteger>>> thread_entries(num_of_threads);
+  const auto index_levels = GetBddIndexLevels();
+  const auto options = Option::Context::Current();
+  auto add_rows = [&](int thread_id) {
+    Option::Context::Scope options_scope(options);
+    std::unordered_map<unsigned, std::map<int, BigInteger>> successor_counts;
+    auto& entries = thread_entries[thread_id];
+    for (int s = thread_id; s < num_of_states; s += num_of_threads) {
+      if (sink_state == s) {
+        continue;
+      }
+      std::map<int, BigInteger> counts;
+      AddSuccessorCounts(this->dfa_->q[s], 0, sink_state, index_levels, successor_counts, counts);
+      for (auto& successor : counts) {
+        entries.push_back(Eigen::Triplet<BigInteger>(s, successor.first, successor.second));
       }
-
       // combine all accepting states into one artifical accepting state
       if (is_accepting_state(s)) {
-        entries.push_back(Eigen::Triplet<BigInteger>(s, this->dfa_->ns, 1));
+        entries.push_back(Eigen::Triplet<BigInteger>(s, num_of_states, 1));
       }
     }
+  };
+
+  std::vector<std::thread> threads;
+  for (int t = 1; t < num_of_threads; ++t) {
+    threads.push_back(std::thread(add_rows, t));
+  }
+  add_rows(0);
+  for (auto& thread : threads) {
+    thread.join();
   }
-  Eigen::SparseMatrix<BigInteger> count_matrix (this->dfa_->ns + 1, this->dfa_->ns + 1);
+
+  std::vector<Eigen::Triplet<BigInteger>> entries;
+  for (auto& thread_entry : thread_entries) {
+    entries.insert(entries.end(), thread_entry.begin(), thread_entry.end());
+  }
+  Eigen::SparseMatrix<BigInteger> count_matrix (num_of_states + 1, num_of_states + 1);
   count_matrix.setFromTriplets(entries.begin(), entries.end());
   decide_counting_schema(count_matrix);
   count_matrix.makeCompressed();
@@ -972,134 +1375,65 @@ void Automaton::SetSymbolicCounter() {
 }
 
 /**
- * Default is set to string variable counting
+ * Level of each bdd index in the variable order of the automaton, the variable at position i
+ * has bdd index variable_indices_[i]
  */
-void Automaton::decide_counting_schema(Eigen::SparseMatrix<BigInteger>& count_matrix) {
-  counter_.set_type(SymbolicCounter::Type::STRING);
-  count_matrix.insert(this->dfa_->ns, this->dfa_->ns) = 1; // allows us to count all lengths up to given bound
+std::vector<int> Automaton::GetBddIndexLevels() const {
+  std::vector<int> index_levels;
+  for (int i = 0; i < num_of_variables_; ++i) {
+    const int index = (variable_indices_ == nullptr) ? i : variable_indices_[i];
+    if (index >= static_cast<int>(index_levels.size())) {
+      index_levels.resize(index + 1, -1);
+    }
+    index_levels[index] = i;
+  }
+  return index_levels;
 }
 
-void Automaton::generateGFScript(int bound, std::ostream& out, bool count_less_than_or_equal_to_bound) {
-  LOG(FATAL) << "Refactor me with CountMatrix or add SparseCountMatrix";
-//  AdjacencyList adjacency_count_list = getAdjacencyCountList();
-//  unsigned node_size = adjacency_count_list.size();
-//  unsigned updated_node_size = node_size + 1;
-//  adjacency_count_list.resize(updated_node_size);
-//
-//  Node artificial;
-//
-//  // add a self-loop if we count up to bound (bound inclusive)
-//  if (count_less_than_or_equal_to_bound) {
-//    artificial.first = node_size;
-//    artificial.second = 1;
-//    adjacency_count_list[node_size].push_back(artificial);
-//  }
-//
-//  for (int i = 0; (unsigned)i < node_size; i++) {
-//    if (is_accepting_state(i)) {
-//      artificial.first = i;
-//      artificial.second = 1;
-//      adjacency_count_list[node_size].push_back(artificial);
-//    }
-//  }
-//
-//  out << "bound = " << bound + 2 << ";\n";
-//  out << "ID = IdentityMatrix[" << updated_node_size << "];\n\n";
-//  out << "A = SparseArray[ { ";
-//  std::string row_seperator = "";
-//  std::string col_seperator = "";
-//  int c = 0;
-//  for (auto& transitions : adjacency_count_list) {
-//    out << row_seperator;
-//    row_seperator = "";
-//    col_seperator = "";
-//    for(auto& node : transitions) {
-//      out << col_seperator;
-//      out << "{" << node.first + 1 << ", " << c + 1 << "} -> " << node.second;
-//      col_seperator = ", ";
-//      row_seperator = ", ";
-//    }
-//    c++;
-//  }
-//  out << "}];\n\n";
-//  out << "X = ID - A t;\n\n";
-//  out << "Xsubmatrix = X[[ {";
-//  std::string seperator = "";
-//  for(unsigned i = 1; i < updated_node_size; i++) {
-//    out << seperator << i;
-//    seperator = ",";
-//  }
-//  out << "},{";
-//  for(unsigned i = 1; i < updated_node_size - 1; i++){
-//    out << i << ",";
-//  }
-//
-//  out << updated_node_size << "}";
-//
-//  out << "]];\n";
-//
-//  out << "b = CoefficientList[-Det[Xsubmatrix],t];\n";
-//  out << "c = CoefficientList[Det[X],t];\n";
-//  out << "maxLen = Max[Map[Length, {b,c}]]\n";
-//  out << "bPadLen = Max[0, maxLen - Length[b]];\n";
-//  out << "cPadLen = Max[0, maxLen - Length[c]];\n";
-//  out << "b = ArrayPad[b, {0, bPadLen}];\n";
-//  out << "c = ArrayPad[c, {0, cPadLen}];\n";
-//  out << "p = -c[[ Range[2,maxLen] ]] / c[[1]];\n";
-//  out << "a = Table[0,{maxLen}];\n";
-//  out << "a[[1]] = b[[1]]/c[[1]];\n";
-//  out << "For[ i = 2, i <= maxLen, i++, a[[i]] = (b[[i]] - Total[c[[2;;i]]*a[[i-1;;1;;-1]]]) / c[[1]] ];\n";
-//  out << "numPaths = LinearRecurrence[p,a,{bound,bound}][[1]];\n";
-//  out << "Print[N[numPaths]];";
-//
-//  out << std::endl;
+/**
+ * Adds the number of symbols that lead from a bdd node to each state except the sink into
+ * 'counts', the variables from level 'depth' on are counted. Counts of a node are computed once
+ * (for the node's own level) and scaled into 'counts' for the levels skipped above it.
+ */
+void Automaton::AddSuccessorCounts(unsigned bdd_node, int depth, int sink_state, const std::vector<int>& index_levels,
+    std::unordered_map<unsigned, std::map<int, BigInteger>>& successor_counts, std::map<int, BigInteger>& counts) {
+  unsigned left, right, index;
+  LOAD_lri(&this->dfa_->bddm->node_table[bdd_node], left, right, index);
+  int node_depth = num_of_variables_;
+  if (index != BDD_LEAF_INDEX) {
+    CHECK_LT(index, index_levels.size()) << "bdd index is not a variable of the automaton";
+    node_depth = index_levels[index];
+    CHECK_GE(node_depth, 0) << "bdd index is not a variable of the automaton";
+  }
+  CHECK_GE(node_depth, depth) << "bdd variables are not in the variable order of the automaton";
+
+  auto it = successor_counts.find(bdd_node);
+  if (it == successor_counts.end()) {
+    std::map<int, BigInteger> node_counts;
+    if (index == BDD_LEAF_INDEX) {
+      if (sink_state != static_cast<int>(left)) {
+        node_counts[left] = 1;
+      }
+    } else {
+      for (unsigned child : {left, right}) {
+        AddSuccessorCounts(child, node_depth + 1, sink_state, index_levels, successor_counts, node_counts);
+      }
+    }
+    it = successor_counts.emplace(bdd_node, std::move(node_counts)).first;
+  }
+
+  const unsigned skipped_levels = node_depth - depth;
+  for (auto& count : it->second) {
+    counts[count.first] += (count.second << skipped_levels);
+  }
 }
 
-void Automaton::generateMatrixScript(int bound, std::ostream& out, bool count_less_than_or_equal_to_bound) {
-  LOG(FATAL) << "Refactor me with CountMatrix or add SparseCountMatrix";
-//  AdjacencyList adjacency_count_list = getAdjacencyCountList();
-//  unsigned node_size = adjacency_count_list.size();
-//  unsigned updated_node_size = node_size + 1;
-//  adjacency_count_list.resize(updated_node_size);
-//
-//  Node artificial;
-//
-//  // add a self-loop if we count up to bound (bound inclusive)
-//  if (count_less_than_or_equal_to_bound) {
-//    artificial.first = node_size;
-//    artificial.second = 1;
-//    adjacency_count_list[node_size].push_back(artificial);
-//  }
-//
-//  for (int i = 0; (unsigned)i < node_size; i++) {
-//    if (is_accepting_state(i)) {
-//      artificial.first = i;
-//      artificial.second = 1;
-//      adjacency_count_list[node_size].push_back(artificial);
-//    }
-//  }
-//
-//  out << "A = SparseArray[{";
-//  std::string row_seperator = "";
-//  std::string col_seperator = "";
-//  int c = 0;
-//  for (auto& transitions : adjacency_count_list) {
-//    out << row_seperator;
-//    row_seperator = "";
-//    col_seperator = "";
-//    for(auto& node : transitions) {
-//      out << col_seperator;
-//      out << "{" << node.first + 1 << ", " << c + 1 << "} -> " << node.second;
-//      col_seperator = ", ";
-//      row_seperator = ", ";
-//    }
-//    c++;
-//  }
-//  out << "}];\n";
-//  // state indexes are off by one
-//  out << "numPaths = MatrixPower[A, " << bound + 2 << "][[" << this->dfa_->s + 1 << ", " << this->dfa_->ns + 1 << "]];\n";
-//  out << "Print[N[numPaths]];";
-//  out << std::endl;
+/**
+ * Default is set to string variable counting
+ */
+void Automaton::decide_counting_schema(Eigen::SparseMatrix<BigInteger>& count_matrix) {
+  counter_.set_type(SymbolicCounter::Type::STRING);
+  count_matrix.insert(this->dfa_->ns, this->dfa_->ns) = 1; // allows us to count all lengths up to given bound
 }
 
 /**
@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
@@ -17,10 +18,14 @@
 #include <iostream>
 #include <iterator>
 #include <map>
+#include <mutex>
+#include <queue>
 #include <set>
 #include <sstream>
 #include <stack>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -38,6 +43,7 @@
 #include "GraphNode.h"
 #include "options/Theory.h"
 #include "SymbolicCounter.h"
+#include "TransitionGraph.h"
 
 namespace Vlab {
 namespace Theory {
@@ -87,6 +93,9 @@ public:
   };
 
   bool IsEqual(Automaton_ptr other_auto);
+  bool IsEqual(Automaton_ptr other_auto, std::vector<std::vector<char>>& counter_example);
+  bool IsSubsetOf(Automaton_ptr other_auto);
+  bool IsSubsetOf(Automaton_ptr other_auto, std::vector<std::vector<char>>& counter_example);
   bool isEmptyLanguage();
   bool is_initial_state_accepting();
   bool isOnlyInitialStateAccepting();
@@ -100,6 +109,7 @@ public:
   SymbolicCounter GetSymbolicCounter();
 
   Graph_ptr toGraph();
+  TransitionGraph_ptr GetTransitionGraph();
 
   void toDotAscii(bool print_sink = false, std::ostream& out = std::cout);
   // TODO merge toDot methods into one with options
@@ -120,11 +130,20 @@ protected:
   static DFA_ptr DfaMakeAnyButNotEmpty(int num_of_variables, int* variable_indices = nullptr);
   static DFA_ptr DfaIntersect(DFA_ptr dfa1, DFA_ptr dfa2);
   static DFA_ptr DfaUnion(DFA_ptr dfa1, DFA_ptr dfa2);
+  static DFA_ptr DfaConcat(DFA_ptr prefix_dfa, DFA_ptr suffix_dfa, int num_of_variables, int* variable_indices);
+  static DFA_ptr DfaConcat(DFA_ptr prefix_dfa, int prefix_state, DFA_ptr suffix_dfa, std::vector<int> suffix_states,
+                           int num_of_variables, int* variable_indices);
+  static DFA_ptr DfaRightQuotient(DFA_ptr subject_dfa, DFA_ptr suffix_dfa);
+  static DFA_ptr DfaLeftQuotient(DFA_ptr subject_dfa, DFA_ptr prefix_dfa, int num_of_variables, int* variable_indices);
+  static void ForEachSuccessorPair(DFA_ptr dfa1, unsigned bdd_node1, DFA_ptr dfa2, unsigned bdd_node2,
+                                   const std::function<void(int, int)>& callback);
   static DFA_ptr DFAProjectAway(int index, DFA_ptr dfa);
 //  static DFA_ptr DFAProjectAway(std::vector<int> index, int num_of_variables, DFA_ptr dfa);
   static DFA_ptr DFAProjectTo(int index, int num_of_variables, DFA_ptr dfa);
   static DFA_ptr DfaL1ToL2(int start, int end, int num_of_variables, int* variable_indices = nullptr);
 
+  bool FindDistinguishingWord(Automaton_ptr other_auto, bool check_inclusion, std::vector<std::vector<char>>* word);
+
   bool isAcceptingSingleWord();
   // TODO update it to work for non-accepting inputs
   std::vector<bool>* getAnAcceptingWord(std::function<bool(unsigned& index)> next_node_heuristic = nullptr);
@@ -156,13 +175,22 @@ protected:
   bool getAnAcceptingWord(NextState& state, std::map<int, bool>& is_stack_member, std::vector<bool>& path, std::function<bool(unsigned& index)> next_node_heuristic = nullptr);
 
   virtual void SetSymbolicCounter();
+  std::vector<int> GetBddIndexLevels() const;
+  void AddSuccessorCounts(unsigned bdd_node, int depth, int sink_state, const std::vector<int>& index_levels,
+                          std::unordered_map<unsigned, std::map<int, BigInteger>>& successor_counts,
+                          std::map<int, BigInteger>& counts);
   virtual void decide_counting_schema(Eigen::SparseMatrix<BigInteger>& mm);
-  void generateGFScript(int bound, std::ostream& out = std::cout, bool count_less_than_or_equal_to_bound = true);
-  void generateMatrixScript(int bound, std::ostream& out = std::cout, bool count_less_than_or_equal_to_bound = true);
 
 
-  bool isCyclic(int state, std::map<int, bool>& is_discovered, std::map<int, bool>& is_stack_member);
-  bool isStateReachableFrom(int search_state, int from_state, std::map<int, bool>& is_stack_member);
+  void ClearTransitionGraph();
+
+  /**
+   * Copies share their dfa, a shared dfa is copied before it is modified in place; every
+   * change to dfa_->f, dfa_->s or the bdds of dfa_ goes after a call to DetachDFA
+   */
+  void DetachDFA();
+  static void AddDFAReference(DFA_ptr dfa);
+  static void ReleaseDFA(DFA_ptr dfa);
 
   /*
    * Operations from LIBSTRANGER
@@ -179,15 +207,19 @@ protected:
 
   const Automaton::Type type_;
   bool is_counter_cached_;
+  TransitionGraph_ptr transition_graph_;
   DFA_ptr dfa_;
   int num_of_variables_;
   int* variable_indices_;
   unsigned long id_;
-  static unsigned long trace_id;
+  static std::atomic<unsigned long> trace_id;
   SymbolicCounter counter_;
 private:
   char* getAnExample(bool accepting=true); // MONA version
-  static int name_counter;
+  static std::atomic<int> name_counter;
+  static std::unordered_map<DFA_ptr, int> dfa_reference_counts;
+  static std::mutex dfa_reference_counts_mutex;
+  static const int PARALLEL_COUNTER_MIN_STATES;
   static const int VLOG_LEVEL;
 };
 
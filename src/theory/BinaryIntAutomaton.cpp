@@ -10,6 +10,8 @@
 
 #include "BinaryIntAutomaton.h"
 
+#include "IntAutomaton.h"
+
 namespace Vlab {
 namespace Theory {
 
@@ -406,6 +408,7 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::TrimLeadingZeros() {
   CHECK_EQ(1, num_of_variables_)<< "trimming is implemented for single track positive binary automaton";
 
   auto tmp_auto = this->clone();
+  tmp_auto->DetachDFA();
 
   // identify leading zeros
   std::vector<char> exception = {'0'};
@@ -676,6 +679,38 @@ UnaryAutomaton_ptr BinaryIntAutomaton::ToUnaryAutomaton() {
   return unary_auto;
 }
 
+/**
+ * Converts a single variable natural number automaton to an int automaton without the unary
+ * round trip. If the automaton accepts exactly the candidate set (e.g., the set it was built
+ * from before an intersection), the candidate is reused instead of extracting the set again.
+ */
+IntAutomaton_ptr BinaryIntAutomaton::ToIntAutomaton(int number_of_variables, bool add_minus_one, SemilinearSet_ptr candidate_set) {
+  BinaryIntAutomaton_ptr trimmed_auto = this->TrimLeadingZeros();
+  SemilinearSet_ptr semilinear_set = nullptr;
+
+  if (candidate_set not_eq nullptr) {
+    std::string var_name = trimmed_auto->formula_->get_variable_coefficient_map().begin()->first;
+    auto candidate_auto = BinaryIntAutomaton::MakeAutomaton(candidate_set, var_name, trimmed_auto->formula_->clone(), false);
+    if (trimmed_auto->IsEqual(candidate_auto)) {
+      semilinear_set = candidate_set->clone();
+    }
+    delete candidate_auto;
+  }
+
+  if (semilinear_set == nullptr) {
+    semilinear_set = trimmed_auto->GetSemilinearSet();
+  }
+  delete trimmed_auto;
+  trimmed_auto = nullptr;
+
+  auto int_auto = IntAutomaton::makeAutomaton(semilinear_set, number_of_variables, add_minus_one);
+  delete semilinear_set;
+  semilinear_set = nullptr;
+
+  DVLOG(VLOG_LEVEL) << int_auto->getId() << " = [" << this->id_ << "]->ToIntAutomaton(" << number_of_variables << ", " << add_minus_one << ")";
+  return int_auto;
+}
+
 std::map<std::string, int> BinaryIntAutomaton::GetAnAcceptingIntForEachVar() {
   std::map<std::string, int> var_values;
   std::map<int, int> values;
@@ -732,40 +767,11 @@ void BinaryIntAutomaton::decide_counting_schema(Eigen::SparseMatrix<BigInteger>&
   }
 }
 
+/**
+ * Bound is the number of bits, sign bit is handled by the symbolic counter
+ */
 BigInteger BinaryIntAutomaton::SymbolicCount(double bound, bool count_less_than_or_equal_to_bound) {
-  std::stringstream cmd;
-  std::string str_result;
-  std::string tmp_result_file = Option::Theory::TMP_PATH + "/arith_result.dot";
-  std::string math_script_path = Option::Theory::SCRIPT_PATH + "/count.m";
-
-  std::ofstream outfile(tmp_result_file.c_str());
-  if (!outfile.good()) {
-    std::cout << "cannot open file: " << tmp_result_file << std::endl;
-    exit(2);
-  }
-
-  this->ToDot(outfile, false);
-
-  cmd << "math -script " << math_script_path << " " << tmp_result_file << " ";
-
-  if (not is_natural_number_) {
-    ++bound;  // consider sign bit
-  }
-
-  if (std::floor(bound) == bound) {
-    cmd << static_cast<int>(bound);
-  } else {
-    cmd << bound;
-  }
-
-  try {
-    DVLOG(VLOG_LEVEL) << "run_cmd(`" << cmd.str() << "`)";
-    str_result = Util::Cmd::run_cmd(cmd.str());
-  } catch (std::string& e) {
-    LOG(ERROR)<< e;
-  }
-
-  return BigInteger(str_result);
+  return Automaton::SymbolicCount(static_cast<int>(std::floor(bound)), count_less_than_or_equal_to_bound);
 }
 
 BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntGraterThanOrEqualToZero(std::vector<int> indexes,
@@ -809,6 +815,57 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntGraterThanOrEqualToZero(std::v
   return postivie_numbers_auto;
 }
 
+BinaryIntAutomaton::TransitionEnumerator::TransitionEnumerator(const std::vector<int>& coefficients)
+    : exception_(coefficients.size() + 1, 'X'),
+      num_of_transitions_(0),
+      index_(0),
+      sum_(0) {
+  for (std::size_t i = 0; i < coefficients.size(); ++i) {
+    if (coefficients[i] != 0) {
+      active_coefficients_.push_back(coefficients[i]);
+      active_positions_.push_back(i);
+    }
+  }
+  exception_[coefficients.size()] = '\0';
+  num_of_transitions_ = 1UL << active_coefficients_.size();
+  Reset();
+}
+
+/**
+ * Moves to the transition where all active variables are 0
+ */
+void BinaryIntAutomaton::TransitionEnumerator::Reset() {
+  for (int position : active_positions_) {
+    exception_[position] = '0';
+  }
+  index_ = 0;
+  sum_ = 0;
+}
+
+/**
+ * Flips the variable at the lowest set bit of the next index, i.e., visits transitions in gray code order
+ * @returns false when all transitions are enumerated
+ */
+bool BinaryIntAutomaton::TransitionEnumerator::Next() {
+  ++index_;
+  if (index_ >= num_of_transitions_) {
+    return false;
+  }
+  int bit = 0;
+  for (unsigned long i = index_; (i & 1) == 0; i >>= 1) {
+    ++bit;
+  }
+  char& value = exception_[active_positions_[bit]];
+  if (value == '0') {
+    value = '1';
+    sum_ += active_coefficients_[bit];
+  } else {
+    value = '0';
+    sum_ -= active_coefficients_[bit];
+  }
+  return true;
+}
+
 BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeEquality(ArithmeticFormula_ptr formula, bool is_natural_number) {
   if (is_natural_number) {
     return MakeNaturalNumberEquality(formula);
@@ -854,66 +911,58 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntEquality(ArithmeticFormula_ptr
   const int total_num_variables = formula->get_number_of_variables();
   const int active_num_variables = total_num_variables - num_of_zero_coefficient;
   CHECK_LT(active_num_variables, 64);
-  // TODO instead of doing shift, try to update algorithm
-  unsigned long transitions = 1 << active_num_variables;  //number of transitions from each state
+  TransitionEnumerator transition_enumerator(coeffs);
+  const unsigned long transitions = transition_enumerator.num_of_transitions();  //number of transitions from each state
 
   int* indices = getIndices(total_num_variables);
   dfaSetup(num_of_states, total_num_variables, indices);
 
   std::map<std::vector<char>, int> transitions_from_initial_state; // populated if initial state is in cycle and accepting
 
-  std::map<int, StateIndices> carry_map;  // maps carries to state indices
-  carry_map[constant].sr = 1;
-  carry_map[constant].i = -1;
-  carry_map[constant].ir = 0;
+  std::vector<StateIndices> carry_map(max - min + 1);  // maps carries (offset by min) to state indices
+  std::vector<int> state_labels {constant};  // maps state indices to carries, states are expanded in index order
+  carry_map[constant - min].sr = 1;
+  carry_map[constant - min].i = -1;
+  carry_map[constant - min].ir = 0;
 
   const bool is_equality = (ArithmeticFormula::Type::EQ == formula->get_type());
   const bool needs_shift_state = (not is_equality);
   bool is_initial_state_shifted = false;
 
-  int next_index = 0,
-      next_label = constant,
-      current_state = 0;
-
-  while (next_label < max + 1) {  //there is a state to expand (excuding sink)
-    if (carry_map[next_label].i == current_state) {
-      carry_map[next_label].s = 2;
+  int current_state = 0;
+  for (; current_state < static_cast<int>(state_labels.size()); ++current_state) {
+    const int label = state_labels[current_state];
+    if (carry_map[label - min].i == current_state) {
+      carry_map[label - min].s = 2;
     } else {
-      carry_map[next_label].sr = 2;
+      carry_map[label - min].sr = 2;
     }
 
     dfaAllocExceptions(transitions / 2);
-    int result, target;
-    for (unsigned long j = 0; j < transitions; j++) {
-      result = next_label + formula->CountOnes(j);
+    transition_enumerator.Reset();
+    do {
+      const int result = label + transition_enumerator.sum();
       if (not (result & 1)) {
-        std::vector<char> binary_string = GetReversedBinaryFormat(j, active_num_variables);
-        std::vector<char> current_exception(total_num_variables, 'X');
-        current_exception.push_back('\0');
-        for (int i = 0, k = 0; i < total_num_variables; i++) {
-          if (coeffs[i] != 0) {
-            current_exception[i] = binary_string[k];
-            ++k;
-          }
-        }
-        target = result / 2;
+        const int target = result / 2;
+        auto& target_indices = carry_map[target - min];
         int to_state;
-        if (target == next_label) {
-          if (carry_map[target].s == 0) {
-            carry_map[target].s = 1;
-            ++next_index;
-            carry_map[target].i = next_index;
+        if (target == label) {
+          if (target_indices.s == 0) {
+            target_indices.s = 1;
+            target_indices.i = state_labels.size();
+            state_labels.push_back(target);
           }
-          to_state = carry_map[target].i;
+          to_state = target_indices.i;
         } else {
-          if (carry_map[target].sr == 0) {
-            carry_map[target].sr = 1;
-            ++next_index;
-            carry_map[target].ir = next_index;
+          if (target_indices.sr == 0) {
+            target_indices.sr = 1;
+            target_indices.ir = state_labels.size();
+            state_labels.push_back(target);
           }
-          to_state = carry_map[target].ir;
+          to_state = target_indices.ir;
         }
 
+        auto& current_exception = transition_enumerator.exception();
         if (needs_shift_state) {
           if (to_state == 0) {
             to_state = shifted_initial_state;
@@ -925,17 +974,9 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntEquality(ArithmeticFormula_ptr
         }
         dfaStoreException(to_state, &current_exception[0]);
       }
-    }
+    } while (transition_enumerator.Next());
 
     dfaStoreState(sink_state);
-
-    ++current_state;
-
-    //find next state to expand
-    for (next_label = min;
-        (next_label <= max) and (carry_map[next_label].i != current_state) and (carry_map[next_label].ir != current_state);
-        ++next_label) {
-    }
   }
 
   for (; current_state < num_of_states; ++current_state) {
@@ -967,12 +1008,12 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntEquality(ArithmeticFormula_ptr
     statuses[i] = initial_status;
   }
 
-  for (next_label = min; next_label <= max; ++next_label) {
-    if (carry_map[next_label].s == 2) {
-      if (carry_map[next_label].i == 0 and is_initial_state_shifted) {
+  for (auto& state_indices : carry_map) {
+    if (state_indices.s == 2) {
+      if (state_indices.i == 0 and is_initial_state_shifted) {
         statuses[shifted_initial_state] = target_status;
       } else {
-        statuses[carry_map[next_label].i] = target_status;
+        statuses[state_indices.i] = target_status;
       }
     }
   }
@@ -1028,52 +1069,44 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberEquality(ArithmeticF
   const int total_num_variables = formula->get_number_of_variables();
   const int active_num_variables = total_num_variables - num_of_zero_coefficient;
   CHECK_LT(active_num_variables, 64);
-  // TODO instead of doing shift, try to update algorithm
-  unsigned long transitions = 1 << active_num_variables;  //number of transitions from each state
+  TransitionEnumerator transition_enumerator(coeffs);
+  const unsigned long transitions = transition_enumerator.num_of_transitions();  //number of transitions from each state
 
   int* indices = getIndices(total_num_variables);
   dfaSetup(num_of_states, total_num_variables, indices);
 
   std::map<std::vector<char>, int> transitions_from_initial_state; // populated if initial state is in cycle and accepting
 
-  std::map<int, StateIndices> carry_map;  // maps carries to state indices
-  carry_map[constant].s = 1;
-  carry_map[constant].i = 0;
+  std::vector<StateIndices> carry_map(max - min + 1);  // maps carries (offset by min) to state indices
+  std::vector<int> state_labels {constant};  // maps state indices to carries, states are expanded in index order
+  carry_map[constant - min].s = 1;
+  carry_map[constant - min].i = 0;
 
   const bool is_equality = (ArithmeticFormula::Type::EQ == formula->get_type());
   const bool needs_shift_state = ((is_equality and constant == 0) or ((not is_equality) and constant != 0));
   bool is_initial_state_shifted = false;
 
-  int next_index = 0,
-      next_label = constant,
-      current_state = 0;
-
-  while (next_label < max + 1) {  //there is a state to expand (excuding sink)
-    carry_map[next_label].s = 2;
+  int current_state = 0;
+  for (; current_state < static_cast<int>(state_labels.size()); ++current_state) {
+    const int label = state_labels[current_state];
+    carry_map[label - min].s = 2;
 
     dfaAllocExceptions(transitions / 2);
-    int result, target;
-    for (unsigned long j = 0; j < transitions; ++j) {
-      result = next_label + formula->CountOnes(j);
+    transition_enumerator.Reset();
+    do {
+      const int result = label + transition_enumerator.sum();
       if (not (result & 1)) {
-        target = result / 2;
-        if (carry_map[target].s == 0) {
-          carry_map[target].s = 1;
-          ++next_index;
-          carry_map[target].i = next_index;
+        const int target = result / 2;
+        auto& target_indices = carry_map[target - min];
+        if (target_indices.s == 0) {
+          target_indices.s = 1;
+          target_indices.i = state_labels.size();
+          state_labels.push_back(target);
         }
 
-        std::vector<char> binary_string = GetReversedBinaryFormat(j, active_num_variables);
-        std::vector<char> current_exception(total_num_variables, 'X');
-        current_exception.push_back('\0');
-        for (int i = 0, k = 0; i < total_num_variables; i++) {
-          if (coeffs[i] != 0) {
-            current_exception[i] = binary_string[k];
-            ++k;
-          }
-        }
+        auto& current_exception = transition_enumerator.exception();
         // hack to avoid an accepting initial state
-        int to_state = carry_map[target].i;
+        int to_state = target_indices.i;
         if (needs_shift_state) { // initial state is accepting, shift it
           if (to_state == 0) {
             to_state = shifted_initial_state;
@@ -1085,18 +1118,9 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberEquality(ArithmeticF
         }
         dfaStoreException(to_state, &current_exception[0]);
       }
-    }
+    } while (transition_enumerator.Next());
 
     dfaStoreState(sink_state);
-
-    ++current_state;
-
-    //find next state to expand
-    for (next_label = min;
-        (next_label <= max) and (carry_map[next_label].i != current_state);
-        ++next_label) {
-    }
-
   }
 
   for (; current_state < num_of_states; ++current_state) {
@@ -1127,11 +1151,11 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberEquality(ArithmeticF
     statuses[i] = initial_status;
   }
 
-  if (carry_map[0].s == 2) {
-    if (carry_map[0].i == 0 and is_initial_state_shifted) {
+  if (carry_map[0 - min].s == 2) {
+    if (carry_map[0 - min].i == 0 and is_initial_state_shifted) {
       statuses[shifted_initial_state] = target_status;
     } else {
-      statuses[carry_map[0].i] = target_status;
+      statuses[carry_map[0 - min].i] = target_status;
     }
   }
 
@@ -1189,34 +1213,34 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntLessThan(ArithmeticFormula_ptr
   const int total_num_variables = formula->get_number_of_variables();
   const int active_num_variables = total_num_variables - num_of_zero_coefficient;
   CHECK_LT(active_num_variables, 64);
-  // TODO instead of doing shift, try to update algorithm
-  unsigned long transitions = 1 << active_num_variables;  //number of transitions from each state
+  TransitionEnumerator transition_enumerator(coeffs);
+  const unsigned long transitions = transition_enumerator.num_of_transitions();  //number of transitions from each state
 
   int* indices = getIndices(total_num_variables);
   dfaSetup(num_of_states, total_num_variables, indices);
 
-  std::map<int, StateIndices> carry_map;  // maps carries to state indices
-  carry_map[constant].sr = 1;
-  carry_map[constant].i = -1;
-  carry_map[constant].ir = 0;
-
-  int next_index = 0,
-      next_label = constant,
-      current_state = 0;
-
-  while (next_label < max + 1) {  //there is a state to expand (excuding sink)
-    if (carry_map[next_label].i == current_state) {
-      carry_map[next_label].s = 2;
+  std::vector<StateIndices> carry_map(max - min + 1);  // maps carries (offset by min) to state indices
+  std::vector<int> state_labels {constant};  // maps state indices to carries, states are expanded in index order
+  carry_map[constant - min].sr = 1;
+  carry_map[constant - min].i = -1;
+  carry_map[constant - min].ir = 0;
+
+  int current_state = 0;
+  for (; current_state < static_cast<int>(state_labels.size()); ++current_state) {
+    const int label = state_labels[current_state];
+    if (carry_map[label - min].i == current_state) {
+      carry_map[label - min].s = 2;
     } else {
-      carry_map[next_label].sr = 2;
+      carry_map[label - min].sr = 2;
     }
 
     // TODO instead of allocating that many of transitions, try to reduce them with a preprocessing
     dfaAllocExceptions(transitions);
-    int result, target, write1, label1, label2;
-    for (unsigned long j = 0; j < transitions; j++) {
-      int ones = formula->CountOnes(j);
-      result = next_label + ones;
+    transition_enumerator.Reset();
+    do {
+      const int ones = transition_enumerator.sum();
+      int result = label + ones;
+      int target, write1, label1, label2;
       if (result >= 0) {
         target = result / 2;
       } else {
@@ -1224,7 +1248,7 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntLessThan(ArithmeticFormula_ptr
       }
 
       write1 = result & 1;
-      label1 = next_label;
+      label1 = label;
       label2 = target;
 
       while (label1 != label2) {
@@ -1238,43 +1262,26 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntLessThan(ArithmeticFormula_ptr
         write1 = result & 1;
       }
 
-      std::vector<char> binary_string = GetReversedBinaryFormat(j, active_num_variables);
-      std::vector<char> current_exception(total_num_variables, 'X');
-      current_exception.push_back('\0');
-      for (int i = 0, k = 0; i < total_num_variables; i++) {
-        if (coeffs[i] != 0) {
-          current_exception[i] = binary_string[k];
-          ++k;
-        }
-      }
-
+      auto& current_exception = transition_enumerator.exception();
+      auto& target_indices = carry_map[target - min];
       if (write1) {
-        if (carry_map[target].s == 0) {
-          carry_map[target].s = 1;
-          next_index++;
-          carry_map[target].i = next_index;
+        if (target_indices.s == 0) {
+          target_indices.s = 1;
+          target_indices.i = state_labels.size();
+          state_labels.push_back(target);
         }
-        dfaStoreException(carry_map[target].i, &current_exception[0]);
+        dfaStoreException(target_indices.i, &current_exception[0]);
       } else {
-        if (carry_map[target].sr == 0) {
-          carry_map[target].sr = 1;
-          next_index++;
-          carry_map[target].ir = next_index;
+        if (target_indices.sr == 0) {
+          target_indices.sr = 1;
+          target_indices.ir = state_labels.size();
+          state_labels.push_back(target);
         }
-        dfaStoreException(carry_map[target].ir, &current_exception[0]);
+        dfaStoreException(target_indices.ir, &current_exception[0]);
       }
-    }
+    } while (transition_enumerator.Next());
 
     dfaStoreState(current_state);
-
-    ++current_state;
-
-    //find next state to expand
-    for (next_label = min;
-        (next_label <= max) and (carry_map[next_label].i != current_state) and (carry_map[next_label].ir != current_state);
-        ++next_label) {
-    }
-
   }
 
   for (; current_state < num_of_states; ++current_state) {
@@ -1288,9 +1295,9 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntLessThan(ArithmeticFormula_ptr
     statuses[i] = '-';
   }
 
-  for (next_label = min; next_label <= max; ++next_label) {
-    if (carry_map[next_label].s == 2) {
-      statuses[carry_map[next_label].i] = '+';
+  for (auto& state_indices : carry_map) {
+    if (state_indices.s == 2) {
+      statuses[state_indices.i] = '+';
     }
   }
   statuses[num_of_states] = '\0';
@@ -1341,74 +1348,58 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberLessThan(ArithmeticF
   const int active_num_variables = total_num_variables - num_of_zero_coefficient;
   CHECK_LT(active_num_variables, 64);
   // TODO instead of allocating that many of transitions, try to reduce them with a preprocessing
-  unsigned long transitions = 1 << active_num_variables;  //number of transitions from each state
+  TransitionEnumerator transition_enumerator(coeffs);
+  const unsigned long transitions = transition_enumerator.num_of_transitions();  //number of transitions from each state
 
   int* indices = getIndices(total_num_variables);
   dfaSetup(num_of_states, total_num_variables, indices);
 
-  std::map<std::vector<char>, int> transitions_from_initial_state; // populated if initial state is in cycle and accepting
+  std::map<std::vector<char>, int> transitions_from_initial_state; // used if initial state is in cycle and accepting
   bool is_initial_state_in_cycle = false;
 
-  std::map<int, StateIndices> carry_map;  // maps carries to state indices
-  carry_map[constant].s = 1;
-  carry_map[constant].i = 0;
-
-  int next_index = 0,
-      next_label = constant,
-      current_state = 0;
+  std::vector<StateIndices> carry_map(max - min + 1);  // maps carries (offset by min) to state indices
+  std::vector<int> state_labels {constant};  // maps state indices to carries, states are expanded in index order
+  carry_map[constant - min].s = 1;
+  carry_map[constant - min].i = 0;
 
-  while (next_label < max + 1) {  //there is a state to expand (excuding sink)
-    carry_map[next_label].s = 2;
+  int current_state = 0;
+  for (; current_state < static_cast<int>(state_labels.size()); ++current_state) {
+    const int label = state_labels[current_state];
+    carry_map[label - min].s = 2;
 
     dfaAllocExceptions(transitions);
-
-    int result, target;
-    for (unsigned long j = 0; j < transitions; ++j) {
-      result = next_label + formula->CountOnes(j);
+    transition_enumerator.Reset();
+    do {
+      const int result = label + transition_enumerator.sum();
+      int target;
       if (result >= 0) {
         target = result / 2;
       } else {
         target = (result - 1) / 2;
       }
 
-      if (carry_map[target].s == 0) {
-        carry_map[target].s = 1;
-        ++next_index;
-        carry_map[target].i = next_index;
-      }
-
-      std::vector<char> binary_string = GetReversedBinaryFormat(j, active_num_variables);
-      std::vector<char> current_exception(total_num_variables, 'X');
-      current_exception.push_back('\0');
-      for (int i = 0, k = 0; i < total_num_variables; i++) {
-        if (coeffs[i] != 0) {
-          current_exception[i] = binary_string[k];
-          ++k;
-        }
+      auto& target_indices = carry_map[target - min];
+      if (target_indices.s == 0) {
+        target_indices.s = 1;
+        target_indices.i = state_labels.size();
+        state_labels.push_back(target);
       }
 
+      auto& current_exception = transition_enumerator.exception();
       // hack to avoid an accepting initial state
-      int to_state = carry_map[target].i;
+      int to_state = target_indices.i;
 
       if (to_state == 0) {
         to_state = shifted_initial_state;
         is_initial_state_in_cycle = true;
       }
-      if (current_state == 0 and is_initial_state_in_cycle) { // save transition for shifted initial start
+      if (current_state == 0) { // save transition for shifted initial start
         transitions_from_initial_state[current_exception] = to_state;
       }
       dfaStoreException(to_state, &current_exception[0]);
-    }
+    } while (transition_enumerator.Next());
 
     dfaStoreState(current_state);
-    ++current_state;
-
-    //find next state to expand
-    for (next_label = min;
-        (next_label <= max) and (carry_map[next_label].i != current_state);
-        ++next_label) {
-    }
-
   }
 
   for (; current_state < num_of_states; ++current_state) {
@@ -1432,13 +1423,13 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberLessThan(ArithmeticF
   }
 
   for (int i = min; i < 0; ++i) {
-    if (carry_map[i].s == 2) {
-      if (carry_map[i].i == 0 ) {
+    if (carry_map[i - min].s == 2) {
+      if (carry_map[i - min].i == 0 ) {
         if (is_initial_state_in_cycle) {
           statuses[shifted_initial_state] = '+';
         }
       } else {
-        statuses[carry_map[i].i] = '+';
+        statuses[carry_map[i - min].i] = '+';
       }
     }
   }
@@ -1663,72 +1654,26 @@ bool BinaryIntAutomaton::is_accepting_binary_state(BinaryState_ptr binary_state,
   return false;
 }
 
+/**
+ * Marks the states that are on a cycle (sink state is marked to stop exploration at it)
+ * @returns true if there is a cycle at all
+ */
 bool BinaryIntAutomaton::GetCycleStatus(std::map<int, bool>& cycle_status) {
-  std::map<int, int> disc;
-  std::map<int, int> low;
-  std::map<int, bool> is_stack_member;
-  std::vector<int> st;
-  std::vector<bool> path;
-  int time = 0;
+  bool is_cyclic = false;
   int sink_state = GetSinkState();
 
-  if (sink_state > 0) {
-    disc[sink_state] = 0;  // avoid exploring sink state
-    is_stack_member[sink_state] = false;  // avoid looping to sink state
+  if (sink_state != -1) {
     cycle_status[sink_state] = true;
   }
-  GetCycleStatus(this->dfa_->s, disc, low, st, is_stack_member, cycle_status, time);
-  DVLOG(VLOG_LEVEL) << cycle_status[-2] << " = [" << this->id_ << "]->getCycleStatus(<constants>)";
-  return cycle_status[-2];  // -2 is to keep if it is cyclic at all or not
-}
-
-void BinaryIntAutomaton::GetCycleStatus(int state, std::map<int, int>& disc, std::map<int, int>& low,
-                                        std::vector<int>& st, std::map<int, bool>& is_stack_member,
-                                        std::map<int, bool>& cycle_status, int& time) {
-  int next_state = 0;
-  std::vector<char> exception = { '0' };
-  int l, r;
-//  std::cout << "visiting: " << state << std::endl;
-  disc[state] = low[state] = time;
-  time++;
-  st.push_back(state);
-  is_stack_member[state] = true;
-
-  l = getNextState(state, exception);
-  exception[0] = '1';
-  r = getNextState(state, exception);
-
-  for (int b = 0; b < 2; b++) {
-    next_state = (b == 0) ? l : r;
-    if (disc.find(next_state) == disc.end()) {
-      GetCycleStatus(next_state, disc, low, st, is_stack_member, cycle_status, time);
-      low[state] = std::min(low[state], low[next_state]);
-    } else if (is_stack_member[next_state]) {
-      low[state] = std::min(low[state], disc[next_state]);
-    }
-  }
-
-  if (low[state] == disc[state]) {  // head of SCC
-    int current_state = st.back();
-
-    while (current_state != state) {
-      st.pop_back();
-      is_stack_member[current_state] = false;
-      cycle_status[current_state] = true;
-      cycle_status[-2] = true;
-      current_state = st.back();
-    }
-
-    is_stack_member[current_state] = false;
-    st.pop_back();
-
-    if (current_state == l or current_state == r) {
-      cycle_status[current_state] = true;
-      cycle_status[-2] = true;
+  auto cyclic_states = GetTransitionGraph()->FindCyclicNodes(this->dfa_->s);
+  for (int s = 0; s < this->dfa_->ns; ++s) {
+    if (cyclic_states[s]) {
+      cycle_status[s] = true;
+      is_cyclic = true;
     }
   }
-
-  return;
+  DVLOG(VLOG_LEVEL) << is_cyclic << " = [" << this->id_ << "]->getCycleStatus(<constants>)";
+  return is_cyclic;
 }
 
 void BinaryIntAutomaton::GetConstants(std::map<int, bool>& cycle_status, std::vector<int>& constants) {
@@ -78,6 +78,7 @@ public:
   BinaryIntAutomaton_ptr AddLeadingZeros();
   SemilinearSet_ptr GetSemilinearSet();
   UnaryAutomaton_ptr ToUnaryAutomaton();
+  IntAutomaton_ptr ToIntAutomaton(int number_of_variables, bool add_minus_one = false, SemilinearSet_ptr candidate_set = nullptr);
 
   std::map<std::string, int> GetAnAcceptingIntForEachVar();
 
@@ -107,8 +108,6 @@ protected:
   void decide_counting_schema(Eigen::SparseMatrix<BigInteger>& count_matrix) override;
 
   bool GetCycleStatus(std::map<int, bool>& cycle_status);
-  void GetCycleStatus(int state, std::map<int, int>& disc, std::map<int, int>& low, std::vector<int>& st,
-            std::map<int, bool>& is_stack_member, std::map<int, bool>& cycle_status, int& time);
 //  bool getConstants(std::vector<int>& constants);
 //  bool getConstants(int state, std::map<int, int>& disc, std::map<int, int>& low, std::vector<int>& st,
 //          std::map<int, bool>& is_stack_member, std::vector<bool>& path, std::vector<int>& constants, int& time);
@@ -127,6 +126,27 @@ protected:
     StateIndices(): i{-1}, ir{-1}, s{0}, sr{0} {}
   };
 
+  /**
+   * Enumerates the transitions of a linear formula in gray code order. Consecutive transitions
+   * differ in a single variable, the coefficient sum and the exception are updated in place.
+   */
+  class TransitionEnumerator {
+   public:
+    TransitionEnumerator(const std::vector<int>& coefficients);
+    void Reset();
+    bool Next();
+    int sum() const {return sum_;}
+    std::vector<char>& exception() {return exception_;}
+    unsigned long num_of_transitions() const {return num_of_transitions_;}
+   private:
+    std::vector<int> active_coefficients_;
+    std::vector<int> active_positions_;
+    std::vector<char> exception_;
+    unsigned long num_of_transitions_;
+    unsigned long index_;
+    int sum_;
+  };
+
   bool is_natural_number_;
   ArithmeticFormula_ptr formula_;
 private:
@@ -36,10 +36,11 @@ public:
       int* variable_indices = BoolAutomaton::DEFAULT_VARIABLE_INDICES);
 
   void toDot();
+
+  static thread_local int DEFAULT_NUM_OF_VARIABLES;
 protected:
   DFA_ptr dfa;
   int num_of_variables;
-  static int DEFAULT_NUM_OF_VARIABLES;
   static int* DEFAULT_VARIABLE_INDICES;
   static unsigned* DEFAULT_UNSIGNED_VARIABLE_INDICES;
 private:
@@ -10,7 +10,7 @@
 namespace Vlab {
 namespace Theory {
 
-int DAGraph::name_counter = 0;
+std::atomic<int> DAGraph::name_counter {0};
 
 DAGraph::DAGraph() :
       graph (nullptr), startNode (nullptr), sinkNode (nullptr) {
@@ -217,22 +217,44 @@ int DAGraph::inspectGraph(bool print_sink) {
   return std::system(dot_cmd.c_str());
 }
 
+/**
+ * Tarjan's algorithm with an explicit path stack, each path entry keeps the next successor to visit
+ */
 void DAGraph::findSCCs(int u, int disc[], int low[], std::stack<int>* st, bool is_stack_member[], int& time) {
-  disc[u] = low[u] = ++time;
-  st->push(u);
-  is_stack_member[u] = true;
-
-  GraphNode_ptr current_node = graph->getNode(u);
-  for (GraphNode_ptr next_node : current_node->getNextNodes()) {
-    int v = next_node->getID();
-    if (disc[v] == -1) {
-      findSCCs(v, disc, low, st, is_stack_member, time);
-      low[u] = std::min(low[u], low[v]);
-    } else if (is_stack_member[v] == true) {
-      low[u] = std::min(low[u], disc[v]);
+  std::vector<std::pair<int, GraphNodeSet::iterator>> path;
+  auto discover = [&](int v) {
+    disc[v] = low[v] = ++time;
+    st->push(v);
+    is_stack_member[v] = true;
+    path.push_back(std::make_pair(v, graph->getNode(v)->getNextNodes().begin()));
+  };
+
+  discover(u);
+  while (not path.empty()) {
+    int v = path.back().first;
+    if (path.back().second != graph->getNode(v)->getNextNodes().end()) {
+      int w = (*path.back().second)->getID();
+      ++path.back().second;
+      if (disc[w] == -1) {
+        discover(w);
+      } else if (is_stack_member[w] == true) {
+        low[v] = std::min(low[v], disc[w]);
+      }
+      continue;
     }
+
+    path.pop_back();
+    if (not path.empty()) {
+      low[path.back().first] = std::min(low[path.back().first], low[v]);
+    }
+    addSCC(v, disc, low, st, is_stack_member);
   }
+}
 
+/**
+ * Pops the scc of 'u' from the stack if 'u' is the head of its scc
+ */
+void DAGraph::addSCC(int u, int disc[], int low[], std::stack<int>* st, bool is_stack_member[]) {
   int w = 0;
   if (low[u] == disc[u]) {
     DAGraphNode_ptr da_current_node = new DAGraphNode(u);
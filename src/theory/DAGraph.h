@@ -9,6 +9,7 @@
 #define THEORY_DAGRAPH_H_
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <iostream>
 #include <map>
@@ -16,6 +17,7 @@
 #include <stack>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "DAGraphNode.h"
 #include "Graph.h"
@@ -64,7 +66,8 @@ protected:
 
 private:
   void findSCCs(int u, int *disc, int *low, std::stack<int> *st, bool *is_stack_member, int& time);
-  static int name_counter;
+  void addSCC(int u, int *disc, int *low, std::stack<int> *st, bool *is_stack_member);
+  static std::atomic<int> name_counter;
 };
 
 } /* namespace Theory */
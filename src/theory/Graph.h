@@ -8,6 +8,7 @@
 #ifndef THEORY_GRAPH_H_
 #define THEORY_GRAPH_H_
 
+#include <atomic>
 #include <cstdlib>
 #include <functional>
 #include <iostream>
@@ -71,7 +72,7 @@ protected:
   GraphNodeMap nodes;
 
 private:
-  static int name_counter;
+  static std::atomic<int> name_counter;
 };
 
 } /* namespace Theory */
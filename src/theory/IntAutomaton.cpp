@@ -7,6 +7,8 @@
 
 #include "IntAutomaton.h"
 
+#include "BinaryIntAutomaton.h"
+
 namespace Vlab {
 namespace Theory {
 
@@ -14,7 +16,7 @@ const int IntAutomaton::INFINITE = -2;
 
 const int IntAutomaton::VLOG_LEVEL = 9;
 
-int IntAutomaton::DEFAULT_NUM_OF_VARIABLES = 8;
+thread_local int IntAutomaton::DEFAULT_NUM_OF_VARIABLES = 8;
 
 IntAutomaton::IntAutomaton(DFA_ptr dfa) :
         Automaton(Automaton::Type::INT, dfa, IntAutomaton::DEFAULT_NUM_OF_VARIABLES),
@@ -217,6 +219,7 @@ IntAutomaton_ptr IntAutomaton::makeInts(std::vector<int> values, int num_of_vari
     auto max = std::max_element(values.begin(), values.end());
 
     int_auto = IntAutomaton::makeInt(*max, num_of_variables);
+    int_auto->DetachDFA();
 
     for (int i : values) {
       if (i < 0) {
@@ -234,6 +237,64 @@ IntAutomaton_ptr IntAutomaton::makeInts(std::vector<int> values, int num_of_vari
   return int_auto;
 }
 
+/**
+ * Builds the automaton of a semilinear set directly, each state steps with any symbol
+ */
+IntAutomaton_ptr IntAutomaton::makeAutomaton(SemilinearSet_ptr semilinear_set, int num_of_variables, bool add_minus_one) {
+  IntAutomaton_ptr int_auto = nullptr;
+  if (semilinear_set->isEmptySet()) {
+    int_auto = IntAutomaton::makePhi(num_of_variables);
+    int_auto->has_negative_1 = add_minus_one;
+    DVLOG(VLOG_LEVEL) << int_auto->id_ << " = IntAutomaton::makeAutomaton(<semilinear set>, " << add_minus_one << ")";
+    return int_auto;
+  }
+
+  const bool has_only_constants = semilinear_set->hasOnlyConstants();
+  const int cycle_head = semilinear_set->getCycleHead();
+  int number_of_states = cycle_head + semilinear_set->getPeriod() + 1;
+  if (has_only_constants) {
+    number_of_states = semilinear_set->getConstants().back() + 2;
+  }
+  const int sink_state = number_of_states - 1;
+  int* indices = getIndices(num_of_variables);
+  std::vector<char> statuses(number_of_states + 1, '-');
+  statuses[number_of_states] = '\0';
+
+  dfaSetup(number_of_states, num_of_variables, indices);
+  for (int s = 0; s < number_of_states - 2; ++s) {
+    dfaAllocExceptions(0);
+    dfaStoreState(s + 1);
+  }
+
+  // last state either ends the constants or closes the cycle
+  dfaAllocExceptions(0);
+  dfaStoreState(has_only_constants ? sink_state : cycle_head);
+
+  dfaAllocExceptions(0);
+  dfaStoreState(sink_state);
+
+  for (auto c : semilinear_set->getConstants()) {
+    statuses[c] = '+';
+  }
+  if (not has_only_constants) {
+    for (auto r : semilinear_set->getPeriodicConstants()) {
+      statuses[cycle_head + r] = '+';
+    }
+  }
+
+  DFA_ptr tmp_dfa = dfaBuild(&statuses[0]);
+  DFA_ptr int_dfa = dfaMinimize(tmp_dfa);
+  dfaFree(tmp_dfa);
+  delete[] indices;
+
+  int_auto = new IntAutomaton(int_dfa, num_of_variables);
+  int_auto->has_negative_1 = add_minus_one;
+
+  DVLOG(VLOG_LEVEL) << int_auto->id_ << " = " << *semilinear_set;
+  DVLOG(VLOG_LEVEL) << int_auto->id_ << " = IntAutomaton::makeAutomaton(<semilinear set>, " << add_minus_one << ")";
+  return int_auto;
+}
+
 void IntAutomaton::setMinus1(bool has_minus_one) {
   has_negative_1 = has_minus_one;
 }
@@ -747,6 +808,86 @@ int IntAutomaton::getAnAcceptingInt() {
   return -2; // not accepting
 }
 
+/**
+ * Reads the semilinear set from the lasso formed by the transitions on the zero symbol,
+ * without building the unary automaton first
+ */
+SemilinearSet_ptr IntAutomaton::getSemilinearSet() {
+  int cycle_head_state = -1,
+          current_state = this->dfa_->s,
+          sink_state = this->GetSinkState();
+
+  if (sink_state == current_state) {
+    return new SemilinearSet();
+  }
+
+  std::vector<char> exception(num_of_variables_, '0');
+  std::vector<int> states;
+  std::map<int, int> values;
+
+  for (int s = 0; s < this->dfa_->ns; ++s) {
+    values[current_state] = s;
+    states.push_back(current_state);
+    int next_state = getNextState(current_state, exception);
+    if (next_state == sink_state) {
+      break;
+    } else if (values.find(next_state) != values.end()) {
+      cycle_head_state = next_state;
+      break;
+    }
+    current_state = next_state;
+  }
+
+  SemilinearSet_ptr semilinear_set = new SemilinearSet();
+  int cycle_head_value = 0;
+  bool is_in_cycle = false;
+  for (auto state : states) {
+    if (not is_in_cycle and state == cycle_head_state) {
+      is_in_cycle = true;
+      cycle_head_value = values[state];
+    }
+    if (is_accepting_state(state)) {
+      if (is_in_cycle) {
+        semilinear_set->addPeriodicConstant(values[state] - cycle_head_value);
+      } else {
+        semilinear_set->addConstant(values[state]);
+      }
+    }
+  }
+
+  semilinear_set->setCycleHead(cycle_head_value);
+  int period = (cycle_head_state == -1) ? 0 : values[states.back()] - cycle_head_value + 1;
+  semilinear_set->setPeriod(period);
+
+  DVLOG(VLOG_LEVEL) << *semilinear_set;
+  DVLOG(VLOG_LEVEL) << "semilinear set = [" << this->id_ << "]->getSemilinearSet()";
+  return semilinear_set;
+}
+
+BinaryIntAutomaton_ptr IntAutomaton::toBinaryIntAutomaton(std::string var_name, ArithmeticFormula_ptr formula, bool add_minus_one) {
+  SemilinearSet_ptr semilinear_set = getSemilinearSet();
+  BinaryIntAutomaton_ptr binary_auto = BinaryIntAutomaton::MakeAutomaton(semilinear_set, var_name, formula, true);
+  delete semilinear_set;
+  semilinear_set = nullptr;
+
+  if (add_minus_one) {
+    BinaryIntAutomaton_ptr minus_one_auto = nullptr, tmp_auto = nullptr;
+    ArithmeticFormula_ptr minus_one_formula = formula->clone();
+    minus_one_formula->reset_coefficients();
+    minus_one_formula->set_variable_coefficient(var_name, 1);
+    minus_one_formula->set_constant(1);
+    minus_one_formula->set_type(ArithmeticFormula::Type::EQ);
+    minus_one_auto = BinaryIntAutomaton::MakeAutomaton(minus_one_formula, false);
+    tmp_auto = binary_auto;
+    binary_auto = tmp_auto->Union(minus_one_auto);
+    delete tmp_auto; tmp_auto = nullptr;
+    delete minus_one_auto; minus_one_auto = nullptr;
+  }
+
+  DVLOG(VLOG_LEVEL) << binary_auto->getId() << " = [" << this->id_ << "]->toBinaryIntAutomaton(" << var_name << ", " << *binary_auto->get_formula() << ", " << add_minus_one << ")";
+  return binary_auto;
+}
+
 UnaryAutomaton_ptr IntAutomaton::toUnaryAutomaton() {
   UnaryAutomaton_ptr unary_auto = nullptr;
   DFA_ptr unary_dfa = nullptr;
@@ -55,6 +55,7 @@ public:
   static IntAutomaton_ptr makeIntGreaterThanOrEqual(int value, int num_of_variables = IntAutomaton::DEFAULT_NUM_OF_VARIABLES);
   static IntAutomaton_ptr makeIntRange(int start, int end, int num_of_variables = IntAutomaton::DEFAULT_NUM_OF_VARIABLES);
   static IntAutomaton_ptr makeInts(std::vector<int> values, int num_of_variables = IntAutomaton::DEFAULT_NUM_OF_VARIABLES);
+  static IntAutomaton_ptr makeAutomaton(SemilinearSet_ptr semilinear_set, int num_of_variables = IntAutomaton::DEFAULT_NUM_OF_VARIABLES, bool add_minus_one = false);
 
   void setMinus1(bool has_minus_one);
   bool hasNegative1();
@@ -104,9 +105,11 @@ public:
   int getAnAcceptingInt();
 
   UnaryAutomaton_ptr toUnaryAutomaton();
+  SemilinearSet_ptr getSemilinearSet();
+  BinaryIntAutomaton_ptr toBinaryIntAutomaton(std::string var_name, ArithmeticFormula_ptr formula, bool add_minus_one = false);
 
   static const int INFINITE;
-  static int DEFAULT_NUM_OF_VARIABLES;
+  static thread_local int DEFAULT_NUM_OF_VARIABLES;
 protected:
   IntAutomaton_ptr __plus(IntAutomaton_ptr other_auto);
   IntAutomaton_ptr __minus(IntAutomaton_ptr other_auto);
@@ -0,0 +1,252 @@
+/*
+ * IntervalDfa.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "IntervalDfa.h"
+
+namespace Vlab {
+namespace Theory {
+
+const int IntervalDfa::VLOG_LEVEL = 20;
+
+const int IntervalDfa::ALPHABET_SIZE;
+
+const int IntervalDfa::REJECT;
+
+IntervalDfa::IntervalDfa()
+    : initial_state_(REJECT) {
+}
+
+IntervalDfa::~IntervalDfa() {
+}
+
+int IntervalDfa::AddState(bool is_accepting) {
+  accepting_states_.push_back(is_accepting);
+  intervals_.push_back(std::vector<Interval>());
+  return accepting_states_.size() - 1;
+}
+
+/**
+ * Adjacent intervals with the same target are merged
+ */
+void IntervalDfa::AddTransition(int state, int first, int last, int target) {
+  if (target == REJECT) {
+    return;
+  }
+  auto& intervals = intervals_[state];
+  CHECK(intervals.empty() or intervals.back().last < first) << "transitions must be added in order";
+  if (not intervals.empty() and intervals.back().last + 1 == first and intervals.back().target == target) {
+    intervals.back().last = last;
+  } else {
+    intervals.push_back(Interval {first, last, target});
+  }
+}
+
+void IntervalDfa::set_initial_state(int state) {
+  initial_state_ = state;
+}
+
+int IntervalDfa::get_initial_state() const {
+  return initial_state_;
+}
+
+int IntervalDfa::num_of_states() const {
+  return accepting_states_.size();
+}
+
+bool IntervalDfa::is_accepting(int state) const {
+  return state != REJECT and accepting_states_[state];
+}
+
+const std::vector<IntervalDfa::Interval>& IntervalDfa::get_intervals(int state) const {
+  return intervals_[state];
+}
+
+int IntervalDfa::NextState(int state, int c) const {
+  if (state == REJECT) {
+    return REJECT;
+  }
+  auto& intervals = intervals_[state];
+  auto it = std::upper_bound(intervals.begin(), intervals.end(), c, [](int value, const Interval& interval) {
+    return value < interval.first;
+  });
+  if (it == intervals.begin()) {
+    return REJECT;
+  }
+  --it;
+  return (c <= it->last) ? it->target : REJECT;
+}
+
+IntervalDfa IntervalDfa::Intersect(const IntervalDfa& other) const {
+  return Product(other, false);
+}
+
+IntervalDfa IntervalDfa::Union(const IntervalDfa& other) const {
+  return Product(other, true);
+}
+
+/**
+ * Subset construction over (left state, set of right states), the initial right state is added
+ * whenever the left state accepts
+ */
+IntervalDfa IntervalDfa::Concat(const IntervalDfa& other) const {
+  IntervalDfa result;
+  if (this->IsEmpty() or other.IsEmpty()) {
+    return result;
+  }
+
+  using MacroState = std::pair<int, std::vector<int>>;
+  std::map<MacroState, int> state_ids;
+  std::vector<MacroState> macro_states;
+
+  auto get_state_id = [&](int left, std::vector<int> right) {
+    if (is_accepting(left)) {
+      right.push_back(other.initial_state_);
+    }
+    std::sort(right.begin(), right.end());
+    right.erase(std::unique(right.begin(), right.end()), right.end());
+    if (left == REJECT and right.empty()) {
+      return static_cast<int>(REJECT);
+    }
+    MacroState macro_state {left, std::move(right)};
+    auto it = state_ids.find(macro_state);
+    if (it != state_ids.end()) {
+      return it->second;
+    }
+    bool is_accepting_state = false;
+    for (int state : macro_state.second) {
+      is_accepting_state = is_accepting_state or other.is_accepting(state);
+    }
+    int id = result.AddState(is_accepting_state);
+    state_ids[macro_state] = id;
+    macro_states.push_back(std::move(macro_state));
+    return id;
+  };
+
+  result.set_initial_state(get_state_id(initial_state_, {}));
+  for (int current = 0; current < result.num_of_states(); ++current) {
+    const MacroState macro_state = macro_states[current];
+    std::vector<const std::vector<Interval>*> interval_tables;
+    if (macro_state.first != REJECT) {
+      interval_tables.push_back(&intervals_[macro_state.first]);
+    }
+    for (int state : macro_state.second) {
+      interval_tables.push_back(&other.intervals_[state]);
+    }
+
+    auto cuts = GetCuts(interval_tables);
+    for (std::size_t i = 0; i + 1 < cuts.size(); ++i) {
+      int c = cuts[i];
+      int left = NextState(macro_state.first, c);
+      std::vector<int> right;
+      for (int state : macro_state.second) {
+        int next_state = other.NextState(state, c);
+        if (next_state != REJECT) {
+          right.push_back(next_state);
+        }
+      }
+      result.AddTransition(current, c, cuts[i + 1] - 1, get_state_id(left, std::move(right)));
+    }
+  }
+
+  DVLOG(VLOG_LEVEL) << "concat: " << num_of_states() << " x " << other.num_of_states() << " -> " << result.num_of_states();
+  return result;
+}
+
+bool IntervalDfa::IsEmpty() const {
+  if (initial_state_ == REJECT) {
+    return true;
+  }
+  std::vector<bool> is_visited(num_of_states(), false);
+  std::queue<int> work_list;
+  work_list.push(initial_state_);
+  is_visited[initial_state_] = true;
+  while (not work_list.empty()) {
+    int state = work_list.front();
+    work_list.pop();
+    if (accepting_states_[state]) {
+      return false;
+    }
+    for (auto& interval : intervals_[state]) {
+      if (not is_visited[interval.target]) {
+        is_visited[interval.target] = true;
+        work_list.push(interval.target);
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * Explores reachable state pairs, a missing state (REJECT) is kept for union only
+ */
+IntervalDfa IntervalDfa::Product(const IntervalDfa& other, bool is_union) const {
+  IntervalDfa result;
+  std::map<std::pair<int, int>, int> state_ids;
+  std::vector<std::pair<int, int>> state_pairs;
+
+  auto get_state_id = [&](int left, int right) {
+    if ((left == REJECT and right == REJECT) or ((not is_union) and (left == REJECT or right == REJECT))) {
+      return static_cast<int>(REJECT);
+    }
+    auto state_pair = std::make_pair(left, right);
+    auto it = state_ids.find(state_pair);
+    if (it != state_ids.end()) {
+      return it->second;
+    }
+    bool is_accepting_state = is_union ?
+        (is_accepting(left) or other.is_accepting(right)) : (is_accepting(left) and other.is_accepting(right));
+    int id = result.AddState(is_accepting_state);
+    state_ids[state_pair] = id;
+    state_pairs.push_back(state_pair);
+    return id;
+  };
+
+  result.set_initial_state(get_state_id(initial_state_, other.initial_state_));
+  for (int current = 0; current < result.num_of_states(); ++current) {
+    const auto state_pair = state_pairs[current];
+    std::vector<const std::vector<Interval>*> interval_tables;
+    if (state_pair.first != REJECT) {
+      interval_tables.push_back(&intervals_[state_pair.first]);
+    }
+    if (state_pair.second != REJECT) {
+      interval_tables.push_back(&other.intervals_[state_pair.second]);
+    }
+
+    auto cuts = GetCuts(interval_tables);
+    for (std::size_t i = 0; i + 1 < cuts.size(); ++i) {
+      int c = cuts[i];
+      int target = get_state_id(NextState(state_pair.first, c), other.NextState(state_pair.second, c));
+      result.AddTransition(current, c, cuts[i + 1] - 1, target);
+    }
+  }
+
+  DVLOG(VLOG_LEVEL) << (is_union ? "union: " : "intersect: ") << num_of_states() << " x " << other.num_of_states()
+                    << " -> " << result.num_of_states();
+  return result;
+}
+
+/**
+ * @returns sorted segment boundaries such that no interval of the tables starts or ends inside a segment
+ */
+std::vector<int> IntervalDfa::GetCuts(const std::vector<const std::vector<Interval>*>& interval_tables) {
+  std::vector<int> cuts {0, ALPHABET_SIZE};
+  for (auto intervals : interval_tables) {
+    for (auto& interval : *intervals) {
+      cuts.push_back(interval.first);
+      cuts.push_back(interval.last + 1);
+    }
+  }
+  std::sort(cuts.begin(), cuts.end());
+  cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+  return cuts;
+}
+
+} /* namespace Theory */
+} /* namespace Vlab */
@@ -0,0 +1,78 @@
+/*
+ * IntervalDfa.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SRC_THEORY_INTERVALDFA_H_
+#define SRC_THEORY_INTERVALDFA_H_
+
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <glog/logging.h>
+
+namespace Vlab {
+namespace Theory {
+
+/**
+ * Byte level dfa without BDDs, transitions of a state are kept as a sorted table of disjoint
+ * character intervals. Characters without an interval go to an implicit rejecting sink (REJECT).
+ * Products and concatenation only explore reachable states and step per interval boundary
+ * instead of per character or per bit.
+ * Conversion to and from MONA dfas is done by StringAutomaton.
+ */
+class IntervalDfa {
+ public:
+  static const int ALPHABET_SIZE = 256;
+  static const int REJECT = -1;
+
+  struct Interval {
+    int first;  // inclusive
+    int last;   // inclusive
+    int target;
+  };
+
+  IntervalDfa();
+  virtual ~IntervalDfa();
+
+  int AddState(bool is_accepting);
+  /**
+   * Transitions of a state must be added in increasing character order
+   */
+  void AddTransition(int state, int first, int last, int target);
+  void set_initial_state(int state);
+  int get_initial_state() const;
+  int num_of_states() const;
+  bool is_accepting(int state) const;
+  const std::vector<Interval>& get_intervals(int state) const;
+  int NextState(int state, int c) const;
+
+  IntervalDfa Intersect(const IntervalDfa& other) const;
+  IntervalDfa Union(const IntervalDfa& other) const;
+  IntervalDfa Concat(const IntervalDfa& other) const;
+  bool IsEmpty() const;
+
+ protected:
+  IntervalDfa Product(const IntervalDfa& other, bool is_union) const;
+  static std::vector<int> GetCuts(const std::vector<const std::vector<Interval>*>& interval_tables);
+
+  int initial_state_;
+  std::vector<bool> accepting_states_;
+  std::vector<std::vector<Interval>> intervals_;
+
+ private:
+  static const int VLOG_LEVEL;
+};
+
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* SRC_THEORY_INTERVALDFA_H_ */
@@ -0,0 +1,140 @@
+/*
+ * LazyIntersection.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "LazyIntersection.h"
+
+namespace Vlab {
+namespace Theory {
+
+const int LazyIntersection::VLOG_LEVEL = 9;
+
+LazyIntersection::LazyIntersection()
+    : num_of_explored_states_(0) {
+}
+
+LazyIntersection::LazyIntersection(const std::vector<StringAutomaton_ptr>& automata)
+    : num_of_explored_states_(0) {
+  for (auto automaton : automata) {
+    Add(automaton);
+  }
+}
+
+LazyIntersection::~LazyIntersection() {
+}
+
+void LazyIntersection::Add(StringAutomaton_ptr automaton) {
+  CHECK(automata_.empty() or automata_.front()->getNumberOfVariables() == automaton->getNumberOfVariables())
+      << "automata must have the same alphabet";
+  automata_.push_back(automaton);
+  sink_states_.push_back(automaton->GetSinkState());
+}
+
+bool LazyIntersection::IsEmpty() {
+  num_of_explored_states_ = 0;
+  if (automata_.empty()) {
+    return false;
+  }
+
+  std::vector<int> initial_states;
+  for (std::size_t i = 0; i < automata_.size(); ++i) {
+    int initial_state = automata_[i]->getDFA()->s;
+    if (initial_state == sink_states_[i]) {
+      return true;
+    }
+    initial_states.push_back(initial_state);
+  }
+
+  std::set<std::vector<int>> visited {initial_states};
+  std::queue<std::vector<int>> work_list;
+  work_list.push(initial_states);
+  std::vector<unsigned> bdd_nodes(automata_.size());
+  while (not work_list.empty()) {
+    const std::vector<int> states = work_list.front();
+    work_list.pop();
+    ++num_of_explored_states_;
+
+    bool is_accepting = true;
+    for (std::size_t i = 0; i < automata_.size() and is_accepting; ++i) {
+      is_accepting = (automata_[i]->getDFA()->f[states[i]] == 1);
+    }
+    if (is_accepting) {
+      DVLOG(VLOG_LEVEL) << "lazy intersection of " << automata_.size() << " automata is not empty, explored "
+                        << num_of_explored_states_ << " states";
+      return false;
+    }
+
+    for (std::size_t i = 0; i < automata_.size(); ++i) {
+      bdd_nodes[i] = automata_[i]->getDFA()->q[states[i]];
+    }
+    AddSuccessors(bdd_nodes, visited, work_list);
+  }
+
+  DVLOG(VLOG_LEVEL) << "lazy intersection of " << automata_.size() << " automata is empty, explored "
+                    << num_of_explored_states_ << " states";
+  return true;
+}
+
+StringAutomaton_ptr LazyIntersection::Materialize() {
+  CHECK(not automata_.empty()) << "nothing to intersect";
+  StringAutomaton_ptr result_auto = automata_.front()->clone();
+  for (std::size_t i = 1; i < automata_.size(); ++i) {
+    StringAutomaton_ptr tmp_auto = result_auto;
+    result_auto = tmp_auto->intersect(automata_[i]);
+    delete tmp_auto;
+  }
+  return result_auto;
+}
+
+int LazyIntersection::num_of_explored_states() const {
+  return num_of_explored_states_;
+}
+
+/**
+ * Walks the bdds of all components together, branching on the smallest variable index among
+ * the inner nodes; leaves that reach a sink state end the walk
+ */
+void LazyIntersection::AddSuccessors(std::vector<unsigned>& bdd_nodes, std::set<std::vector<int>>& visited,
+                                     std::queue<std::vector<int>>& work_list) {
+  unsigned l, r, index;
+  unsigned min_index = BDD_LEAF_INDEX;
+  std::vector<int> next_states(automata_.size());
+  for (std::size_t i = 0; i < automata_.size(); ++i) {
+    LOAD_lri(&automata_[i]->getDFA()->bddm->node_table[bdd_nodes[i]], l, r, index);
+    if (index == BDD_LEAF_INDEX) {
+      if (static_cast<int>(l) == sink_states_[i]) {
+        return;
+      }
+      next_states[i] = l;
+    } else if (min_index == BDD_LEAF_INDEX or index < min_index) {
+      min_index = index;
+    }
+  }
+
+  if (min_index == BDD_LEAF_INDEX) {
+    if (visited.insert(next_states).second) {
+      work_list.push(next_states);
+    }
+    return;
+  }
+
+  std::vector<unsigned> low_nodes = bdd_nodes, high_nodes = bdd_nodes;
+  for (std::size_t i = 0; i < automata_.size(); ++i) {
+    LOAD_lri(&automata_[i]->getDFA()->bddm->node_table[bdd_nodes[i]], l, r, index);
+    if (index == min_index) {
+      low_nodes[i] = l;
+      high_nodes[i] = r;
+    }
+  }
+  AddSuccessors(low_nodes, visited, work_list);
+  AddSuccessors(high_nodes, visited, work_list);
+}
+
+} /* namespace Theory */
+} /* namespace Vlab */
@@ -0,0 +1,64 @@
+/*
+ * LazyIntersection.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SRC_THEORY_LAZYINTERSECTION_H_
+#define SRC_THEORY_LAZYINTERSECTION_H_
+
+#include <queue>
+#include <set>
+#include <vector>
+
+#include <glog/logging.h>
+#include <mona/bdd.h>
+#include <mona/dfa.h>
+
+#include "StringAutomaton.h"
+
+namespace Vlab {
+namespace Theory {
+
+/**
+ * Intersection of string automata that is explored on demand.
+ * Emptiness is decided with a breadth first search over the product states that stops at the
+ * first accepting product state, successors are read by walking the bdds of all automata
+ * together and product states with a sink component are pruned.
+ * The product dfa is only built by Materialize().
+ * Automata are not owned and must outlive the object.
+ */
+class LazyIntersection {
+ public:
+  LazyIntersection();
+  LazyIntersection(const std::vector<StringAutomaton_ptr>& automata);
+  virtual ~LazyIntersection();
+
+  void Add(StringAutomaton_ptr automaton);
+  bool IsEmpty();
+  /**
+   * @returns intersection of the automata, caller owns the result
+   */
+  StringAutomaton_ptr Materialize();
+  int num_of_explored_states() const;
+
+ protected:
+  void AddSuccessors(std::vector<unsigned>& bdd_nodes, std::set<std::vector<int>>& visited,
+                     std::queue<std::vector<int>>& work_list);
+
+  std::vector<StringAutomaton_ptr> automata_;
+  std::vector<int> sink_states_;
+  int num_of_explored_states_;
+
+ private:
+  static const int VLOG_LEVEL;
+};
+
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* SRC_THEORY_LAZYINTERSECTION_H_ */
@@ -10,7 +10,7 @@
 namespace Vlab {
 namespace Theory {
 
-MultiTrackAutomaton::TransitionTable MultiTrackAutomaton::transition_table;
+thread_local MultiTrackAutomaton::TransitionTable MultiTrackAutomaton::transition_table;
 const int MultiTrackAutomaton::VLOG_LEVEL = 20;
 
 MultiTrackAutomaton::MultiTrackAutomaton(DFA_ptr dfa, int num_tracks)
@@ -1965,92 +1965,20 @@ DFA_ptr MultiTrackAutomaton::trim_lambda_suffix(DFA_ptr dfa, int var, bool proje
 }
 
 DFA_ptr MultiTrackAutomaton::trim_prefix(DFA_ptr subject_dfa, DFA_ptr trim_dfa, int var) {
-  DFA_ptr temp_dfa = nullptr, result_dfa = nullptr;
-  MultiTrackAutomaton_ptr temp_multi = nullptr, subject_multi = nullptr,
-                          trim_multi = nullptr, intersect_multi = nullptr;
-  StringAutomaton_ptr result_string_auto = nullptr;
-
-  // (x,x,lambda) until track 2 is lambda
-  // (x,lambda,x) until end
-  temp_multi = makePrefixSuffix(0,1,2,3);
-  subject_multi = new MultiTrackAutomaton(subject_dfa,0,3, DEFAULT_NUM_VAR);
-  trim_multi = new MultiTrackAutomaton(trim_dfa,1,3, DEFAULT_NUM_VAR);
-
-  intersect_multi = temp_multi->intersect(subject_multi);
-  delete temp_multi;
-  delete subject_multi;
-
-  temp_multi = intersect_multi;
-  intersect_multi = temp_multi->intersect(trim_multi);
-  delete temp_multi;
-  delete trim_multi;
-
-  // 3rd track has lambda prefix, so get it (automatically removes lambda prefix/suffix)
-  result_string_auto = intersect_multi->getKTrack(2);
-  result_dfa = dfaCopy(result_string_auto->getDFA());
-  delete intersect_multi;
-  delete result_string_auto;
-
+  int* indices = getIndices(var);
+  DFA_ptr result_dfa = Automaton::DfaLeftQuotient(subject_dfa, trim_dfa, var, indices);
+  delete[] indices;
   return result_dfa;
 }
 
 DFA_ptr MultiTrackAutomaton::trim_suffix(DFA_ptr subject_dfa, DFA_ptr trim_dfa, int var) {
-  DFA_ptr temp_dfa = nullptr, result_dfa = nullptr;
-  MultiTrackAutomaton_ptr temp_multi = nullptr, subject_multi = nullptr,
-                          trim_multi = nullptr, intersect_multi = nullptr;
-  StringAutomaton_ptr result_string_auto = nullptr;
-
-  // (x,x,lambda) until track 2 is lambda
-  // (x,lambda,x) until end
-  temp_multi = makePrefixSuffix(0,1,2,3);
-  subject_multi = new MultiTrackAutomaton(subject_dfa,0,3,DEFAULT_NUM_VAR);
-  // gotta prepend trim_dfa first, to go on track 3
-  temp_dfa = prepend_lambda(trim_dfa,var);
-  trim_multi = new MultiTrackAutomaton(temp_dfa,2,3,VAR_PER_TRACK);
-  dfaFree(temp_dfa);
-
-  intersect_multi = temp_multi->intersect(subject_multi);
-  delete temp_multi;
-  delete subject_multi;
-
-  temp_multi = intersect_multi;
-  intersect_multi = temp_multi->intersect(trim_multi);
-  delete temp_multi;
-  delete trim_multi;
-
-  result_string_auto = intersect_multi->getKTrack(1);
-  result_dfa = dfaCopy(result_string_auto->getDFA());
-  delete intersect_multi;
-  delete result_string_auto;
-
-  return result_dfa;
+  return Automaton::DfaRightQuotient(subject_dfa, trim_dfa);
 }
 
 DFA_ptr MultiTrackAutomaton::concat(DFA_ptr prefix_dfa, DFA_ptr suffix_dfa, int var) {
-  DFA_ptr temp_dfa = nullptr, result_dfa = nullptr;
-  MultiTrackAutomaton_ptr temp_multi = nullptr, prefix_multi = nullptr,
-                          suffix_multi = nullptr, intersect_multi = nullptr;
-  StringAutomaton_ptr result_string_auto = nullptr;
-
-  // (x,x,lambda) until track 2 is lambda
-  // (x,lambda,x) until end
-
-  temp_multi = makePrefixSuffix(0,1,2,3);
-  prefix_multi = new MultiTrackAutomaton(prefix_dfa,1,3,var);
-  temp_dfa = prepend_lambda(suffix_dfa,var);
-  suffix_multi = new MultiTrackAutomaton(temp_dfa,2,3,VAR_PER_TRACK);
-  dfaFree(temp_dfa);
-  intersect_multi = temp_multi->intersect(prefix_multi);
-  delete temp_multi;
-  delete prefix_multi;
-  temp_multi = intersect_multi;
-  intersect_multi = temp_multi->intersect(suffix_multi);
-  delete temp_multi;
-  delete suffix_multi;
-  result_string_auto = intersect_multi->getKTrack(0);
-  result_dfa = dfaCopy(result_string_auto->getDFA());
-  delete intersect_multi;
-  delete result_string_auto;
+  int* indices = getIndices(var);
+  DFA_ptr result_dfa = Automaton::DfaConcat(prefix_dfa, suffix_dfa, var, indices);
+  delete[] indices;
   return result_dfa;
 }
 
@@ -86,7 +86,7 @@ class MultiTrackAutomaton: public Automaton {
  private:
 
  	StringRelation_ptr relation;
- 	static TransitionTable transition_table;
+ 	static thread_local TransitionTable transition_table;
 	static const int VLOG_LEVEL;
 
 };
@@ -0,0 +1,335 @@
+/*
+ * RegexCompiler.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "RegexCompiler.h"
+
+namespace Vlab {
+namespace Theory {
+
+const int RegexCompiler::VLOG_LEVEL = 20;
+
+RegexCompiler::RegexCompiler(Util::RegularExpression_ptr regular_expression)
+    : regular_expression_(regular_expression),
+      nfa_accepting_state_(-1) {
+  char_classes_.fill(0);
+}
+
+RegexCompiler::~RegexCompiler() {
+}
+
+bool RegexCompiler::IsSupported(Util::RegularExpression_ptr regular_expression) {
+  switch (regular_expression->type()) {
+    case Util::RegularExpression::Type::UNION:
+    case Util::RegularExpression::Type::CONCATENATION:
+      return IsSupported(regular_expression->get_expr1()) and IsSupported(regular_expression->get_expr2());
+    case Util::RegularExpression::Type::OPTIONAL:
+    case Util::RegularExpression::Type::REPEAT_STAR:
+    case Util::RegularExpression::Type::REPEAT_PLUS:
+    case Util::RegularExpression::Type::REPEAT_MIN:
+    case Util::RegularExpression::Type::REPEAT_MINMAX:
+      return IsSupported(regular_expression->get_expr1());
+    case Util::RegularExpression::Type::CHAR:
+    case Util::RegularExpression::Type::CHAR_RANGE:
+    case Util::RegularExpression::Type::ANYCHAR:
+    case Util::RegularExpression::Type::EMPTY:
+    case Util::RegularExpression::Type::STRING:
+    case Util::RegularExpression::Type::ANYSTRING:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * Subset construction over character classes, the empty subset becomes the sink state
+ */
+void RegexCompiler::Compile() {
+  nfa_states_.clear();
+  char_sets_.clear();
+  char_set_indices_.clear();
+  auto nfa = Build(regular_expression_);
+  nfa_accepting_state_ = nfa.second;
+  ComputeCharClasses();
+
+  const int num_of_classes = class_representatives_.size();
+  // char set membership of each class
+  std::vector<std::vector<bool>> class_in_set(char_sets_.size(), std::vector<bool>(num_of_classes));
+  for (std::size_t i = 0; i < char_sets_.size(); ++i) {
+    for (int k = 0; k < num_of_classes; ++k) {
+      class_in_set[i][k] = char_sets_[i].test(class_representatives_[k]);
+    }
+  }
+
+  std::map<std::vector<int>, int> dfa_state_ids;
+  std::vector<std::vector<int>> dfa_states;
+  dfa_transitions_.clear();
+  dfa_accepting_states_.clear();
+
+  auto get_dfa_state = [&](std::vector<int> subset) {
+    auto it = dfa_state_ids.find(subset);
+    if (it != dfa_state_ids.end()) {
+      return it->second;
+    }
+    int id = dfa_states.size();
+    dfa_state_ids[subset] = id;
+    dfa_accepting_states_.push_back(std::binary_search(subset.begin(), subset.end(), nfa_accepting_state_));
+    dfa_states.push_back(std::move(subset));
+    return id;
+  };
+
+  get_dfa_state(Closure({nfa.first}));
+  for (std::size_t current = 0; current < dfa_states.size(); ++current) {
+    std::vector<std::vector<int>> targets(num_of_classes);
+    for (int nfa_state : dfa_states[current]) {
+      for (auto& transition : nfa_states_[nfa_state].transitions) {
+        for (int k = 0; k < num_of_classes; ++k) {
+          if (class_in_set[transition.first][k]) {
+            targets[k].push_back(transition.second);
+          }
+        }
+      }
+    }
+    for (int k = 0; k < num_of_classes; ++k) {
+      int next = get_dfa_state(Closure(std::move(targets[k])));
+      dfa_transitions_.push_back(next);
+    }
+  }
+
+  DVLOG(VLOG_LEVEL) << "regex compiled, nfa states: " << nfa_states_.size() << ", character classes: "
+                    << num_of_classes << ", dfa states: " << dfa_states.size();
+}
+
+int RegexCompiler::num_of_states() const {
+  return dfa_accepting_states_.size();
+}
+
+bool RegexCompiler::is_accepting(const int state) const {
+  return dfa_accepting_states_[state];
+}
+
+int RegexCompiler::next_state(const int state, const unsigned char c) const {
+  return dfa_transitions_[state * class_representatives_.size() + char_classes_[c]];
+}
+
+int RegexCompiler::AddState() {
+  nfa_states_.push_back(NfaState());
+  return nfa_states_.size() - 1;
+}
+
+int RegexCompiler::AddCharSet(const CharSet& char_set) {
+  auto key = char_set.to_string();
+  auto it = char_set_indices_.find(key);
+  if (it != char_set_indices_.end()) {
+    return it->second;
+  }
+  char_sets_.push_back(char_set);
+  char_set_indices_[key] = char_sets_.size() - 1;
+  return char_sets_.size() - 1;
+}
+
+void RegexCompiler::AddEpsilon(const int from, const int to) {
+  nfa_states_[from].epsilon_transitions.push_back(to);
+}
+
+void RegexCompiler::AddTransition(const int from, const CharSet& char_set, const int to) {
+  int char_set_index = AddCharSet(char_set);
+  nfa_states_[from].transitions.push_back(std::make_pair(char_set_index, to));
+}
+
+/**
+ * Thompson construction, returns the start and the end state of the fragment
+ */
+std::pair<int, int> RegexCompiler::Build(Util::RegularExpression_ptr regular_expression) {
+  int start = -1, end = -1;
+  switch (regular_expression->type()) {
+    case Util::RegularExpression::Type::UNION: {
+      auto left = Build(regular_expression->get_expr1());
+      auto right = Build(regular_expression->get_expr2());
+      start = AddState();
+      end = AddState();
+      AddEpsilon(start, left.first);
+      AddEpsilon(start, right.first);
+      AddEpsilon(left.second, end);
+      AddEpsilon(right.second, end);
+      break;
+    }
+    case Util::RegularExpression::Type::CONCATENATION: {
+      auto left = Build(regular_expression->get_expr1());
+      auto right = Build(regular_expression->get_expr2());
+      AddEpsilon(left.second, right.first);
+      start = left.first;
+      end = right.second;
+      break;
+    }
+    case Util::RegularExpression::Type::OPTIONAL:
+      return BuildRepeat(regular_expression->get_expr1(), 0, 1, true);
+    case Util::RegularExpression::Type::REPEAT_STAR:
+      return BuildRepeat(regular_expression->get_expr1(), 0, 0, false);
+    case Util::RegularExpression::Type::REPEAT_PLUS:
+      return BuildRepeat(regular_expression->get_expr1(), 1, 0, false);
+    case Util::RegularExpression::Type::REPEAT_MIN:
+      return BuildRepeat(regular_expression->get_expr1(), regular_expression->get_min(), 0, false);
+    case Util::RegularExpression::Type::REPEAT_MINMAX:
+      return BuildRepeat(regular_expression->get_expr1(), regular_expression->get_min(), regular_expression->get_max(), true);
+    case Util::RegularExpression::Type::CHAR: {
+      CharSet char_set;
+      char_set.set(static_cast<unsigned char>(regular_expression->get_character()));
+      start = AddState();
+      end = AddState();
+      AddTransition(start, char_set, end);
+      break;
+    }
+    case Util::RegularExpression::Type::CHAR_RANGE: {
+      int from = static_cast<unsigned char>(regular_expression->get_from_character());
+      int to = static_cast<unsigned char>(regular_expression->get_to_character());
+      if (from > to) {
+        std::swap(from, to);
+      }
+      CharSet char_set;
+      for (int c = from; c <= to; ++c) {
+        char_set.set(c);
+      }
+      start = AddState();
+      end = AddState();
+      AddTransition(start, char_set, end);
+      break;
+    }
+    case Util::RegularExpression::Type::ANYCHAR: {
+      start = AddState();
+      end = AddState();
+      AddTransition(start, CharSet().set(), end);
+      break;
+    }
+    case Util::RegularExpression::Type::EMPTY: {
+      start = AddState();
+      end = AddState();
+      break;
+    }
+    case Util::RegularExpression::Type::STRING: {
+      start = AddState();
+      end = start;
+      for (char c : regular_expression->get_string()) {
+        CharSet char_set;
+        char_set.set(static_cast<unsigned char>(c));
+        int next = AddState();
+        AddTransition(end, char_set, next);
+        end = next;
+      }
+      break;
+    }
+    case Util::RegularExpression::Type::ANYSTRING: {
+      start = AddState();
+      end = AddState();
+      AddTransition(start, CharSet().set(), start);
+      AddEpsilon(start, end);
+      break;
+    }
+    default:
+      LOG(FATAL)<< "Unsupported regular expression" << *regular_expression;
+      break;
+  }
+  return std::make_pair(start, end);
+}
+
+/**
+ * Builds min copies followed by either a loop or (max - min) nested optional copies
+ */
+std::pair<int, int> RegexCompiler::BuildRepeat(Util::RegularExpression_ptr regular_expression, unsigned long min,
+                                               unsigned long max, bool is_bounded) {
+  int start = AddState();
+  int end = start;
+  if (is_bounded and max < min) {
+    return std::make_pair(start, AddState());
+  }
+
+  for (unsigned long i = 0; i < min; ++i) {
+    auto copy = Build(regular_expression);
+    AddEpsilon(end, copy.first);
+    end = copy.second;
+  }
+
+  if (is_bounded) {
+    int optional_end = AddState();
+    for (unsigned long i = min; i < max; ++i) {
+      auto copy = Build(regular_expression);
+      AddEpsilon(end, copy.first);
+      AddEpsilon(end, optional_end);
+      end = copy.second;
+    }
+    AddEpsilon(end, optional_end);
+    end = optional_end;
+  } else {
+    auto loop = Build(regular_expression);
+    int loop_end = AddState();
+    AddEpsilon(end, loop.first);
+    AddEpsilon(end, loop_end);
+    AddEpsilon(loop.second, loop.first);
+    AddEpsilon(loop.second, loop_end);
+    end = loop_end;
+  }
+
+  return std::make_pair(start, end);
+}
+
+/**
+ * Partitions the alphabet such that characters in the same class belong to the same char sets
+ */
+void RegexCompiler::ComputeCharClasses() {
+  char_classes_.fill(0);
+  int num_of_classes = 1;
+  for (auto& char_set : char_sets_) {
+    std::map<std::pair<int, bool>, int> refined_classes;
+    for (int c = 0; c < ALPHABET_SIZE; ++c) {
+      auto key = std::make_pair(char_classes_[c], static_cast<bool>(char_set.test(c)));
+      auto it = refined_classes.find(key);
+      if (it == refined_classes.end()) {
+        it = refined_classes.insert(std::make_pair(key, static_cast<int>(refined_classes.size()))).first;
+      }
+      char_classes_[c] = it->second;
+    }
+    num_of_classes = refined_classes.size();
+  }
+
+  class_representatives_.assign(num_of_classes, 0);
+  std::vector<bool> has_representative(num_of_classes, false);
+  for (int c = 0; c < ALPHABET_SIZE; ++c) {
+    if (not has_representative[char_classes_[c]]) {
+      has_representative[char_classes_[c]] = true;
+      class_representatives_[char_classes_[c]] = c;
+    }
+  }
+}
+
+/**
+ * @returns sorted epsilon closure of the states
+ */
+std::vector<int> RegexCompiler::Closure(std::vector<int> states) const {
+  std::vector<bool> is_visited(nfa_states_.size(), false);
+  std::vector<int> closure;
+  while (not states.empty()) {
+    int state = states.back();
+    states.pop_back();
+    if (is_visited[state]) {
+      continue;
+    }
+    is_visited[state] = true;
+    closure.push_back(state);
+    for (int next : nfa_states_[state].epsilon_transitions) {
+      if (not is_visited[next]) {
+        states.push_back(next);
+      }
+    }
+  }
+  std::sort(closure.begin(), closure.end());
+  return closure;
+}
+
+} /* namespace Theory */
+} /* namespace Vlab */
@@ -0,0 +1,88 @@
+/*
+ * RegexCompiler.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SRC_THEORY_REGEXCOMPILER_H_
+#define SRC_THEORY_REGEXCOMPILER_H_
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include "../utils/RegularExpression.h"
+
+namespace Vlab {
+namespace Theory {
+
+/**
+ * Compiles a regular expression into a single deterministic automaton over 8-bit characters.
+ * A Thompson nfa is built for the whole expression and determinized once, transitions are
+ * computed per character class (characters no sub-expression distinguishes) instead of per
+ * character. Intersection and complement are not supported (see IsSupported).
+ * State 0 is the initial state, the result is not minimized.
+ */
+class RegexCompiler {
+ public:
+  static const int ALPHABET_SIZE = 256;
+  using CharSet = std::bitset<ALPHABET_SIZE>;
+
+  RegexCompiler(Util::RegularExpression_ptr regular_expression);
+  virtual ~RegexCompiler();
+
+  static bool IsSupported(Util::RegularExpression_ptr regular_expression);
+
+  void Compile();
+  int num_of_states() const;
+  bool is_accepting(const int state) const;
+  int next_state(const int state, const unsigned char c) const;
+
+ protected:
+  struct NfaState {
+    std::vector<int> epsilon_transitions;
+    std::vector<std::pair<int, int>> transitions;  // char set index, target state
+  };
+
+  int AddState();
+  int AddCharSet(const CharSet& char_set);
+  void AddEpsilon(const int from, const int to);
+  void AddTransition(const int from, const CharSet& char_set, const int to);
+  std::pair<int, int> Build(Util::RegularExpression_ptr regular_expression);
+  std::pair<int, int> BuildRepeat(Util::RegularExpression_ptr regular_expression, unsigned long min, unsigned long max, bool is_bounded);
+  void ComputeCharClasses();
+  std::vector<int> Closure(std::vector<int> states) const;
+
+  Util::RegularExpression_ptr regular_expression_;
+  std::vector<NfaState> nfa_states_;
+  std::vector<CharSet> char_sets_;
+  std::map<std::string, int> char_set_indices_;
+  int nfa_accepting_state_;
+
+  /**
+   * Character to class mapping and one representative character per class
+   */
+  std::array<int, ALPHABET_SIZE> char_classes_;
+  std::vector<unsigned char> class_representatives_;
+
+  std::vector<int> dfa_transitions_;
+  std::vector<bool> dfa_accepting_states_;
+
+ private:
+  static const int VLOG_LEVEL;
+};
+
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* SRC_THEORY_REGEXCOMPILER_H_ */
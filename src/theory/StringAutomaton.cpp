@@ -12,9 +12,9 @@ namespace Theory {
 
 const int StringAutomaton::VLOG_LEVEL = 8;
 
-int StringAutomaton::name_counter = 0;
+std::atomic<int> StringAutomaton::name_counter {0};
 
-int StringAutomaton::DEFAULT_NUM_OF_VARIABLES = 8;
+thread_local int StringAutomaton::DEFAULT_NUM_OF_VARIABLES = 8;
 
 StringAutomaton::StringAutomaton(DFA_ptr dfa)
         : Automaton(Automaton::Type::STRING, dfa, StringAutomaton::DEFAULT_NUM_OF_VARIABLES) {
@@ -79,8 +79,14 @@ StringAutomaton_ptr StringAutomaton::makeString(std::string str, int num_of_vari
     return StringAutomaton::makeEmptyString();
   }
 
+  auto cache_key = StringAutomatonCache::MakeStringKey(str, num_of_variables);
+  StringAutomaton_ptr result_auto = StringAutomatonCache::Instance().Get(cache_key);
+  if (result_auto != nullptr) {
+    DVLOG(VLOG_LEVEL) << result_auto->id_ << " = makeString(\"" << str << "\") (cached)";
+    return result_auto;
+  }
+
   DFA_ptr result_dfa = nullptr;
-  StringAutomaton_ptr result_auto = nullptr;
   int str_length = str.length();
   int number_of_states = str_length + 2;
   char* statuses = new char[number_of_states];
@@ -110,12 +116,56 @@ StringAutomaton_ptr StringAutomaton::makeString(std::string str, int num_of_vari
   result_auto = new StringAutomaton(result_dfa, num_of_variables);
   delete[] statuses;
   delete[] variable_indices;
+  StringAutomatonCache::Instance().Put(cache_key, result_auto);
 
   DVLOG(VLOG_LEVEL) << result_auto->id_ << " = makeString(\"" << str << "\")";
 
   return result_auto;
 }
 
+/**
+ * Builds the minimal acyclic automaton accepting exactly the given strings without
+ * pairwise unions, see StringSetCompiler
+ */
+StringAutomaton_ptr StringAutomaton::makeStrings(const std::vector<std::string>& strs, int num_of_variables) {
+  if (strs.empty()) {
+    return StringAutomaton::makePhi(num_of_variables);
+  }
+
+  StringSetCompiler string_set_compiler(strs);
+  string_set_compiler.Compile();
+
+  const int sink_state = string_set_compiler.num_of_states();
+  const int number_of_states = sink_state + 1;
+  char* statuses = new char[number_of_states + 1];
+  int* variable_indices = getIndices(num_of_variables);
+
+  dfaSetup(number_of_states, num_of_variables, variable_indices);
+  for (int state = 0; state < sink_state; ++state) {
+    auto& transitions = string_set_compiler.get_transitions(state);
+    dfaAllocExceptions(transitions.size());
+    for (auto& transition : transitions) {
+      dfaStoreException(transition.second, &*(GetBinaryFormat(transition.first, num_of_variables)).begin());
+    }
+    dfaStoreState(sink_state);
+    statuses[state] = string_set_compiler.is_accepting(state) ? '+' : '-';
+  }
+
+  dfaAllocExceptions(0);
+  dfaStoreState(sink_state);
+  statuses[sink_state] = '-';
+  statuses[number_of_states] = '\0';
+
+  DFA_ptr result_dfa = dfaBuild(statuses);
+  StringAutomaton_ptr result_auto = new StringAutomaton(result_dfa, num_of_variables);
+  delete[] statuses;
+  delete[] variable_indices;
+
+  DVLOG(VLOG_LEVEL) << result_auto->id_ << " = makeStrings(<" << strs.size() << " strings>)";
+
+  return result_auto;
+}
+
 /**
  * Returns Sigma*
  *
@@ -233,10 +283,16 @@ StringAutomaton_ptr StringAutomaton::makeAnyChar(int num_of_variables) {
 }
 
 StringAutomaton_ptr StringAutomaton::makeRegexAuto(std::string regex, int num_of_variables) {
-  StringAutomaton_ptr regex_auto = nullptr;
+  auto cache_key = StringAutomatonCache::MakeRegexKey(regex, Util::RegularExpression::DEFAULT, num_of_variables);
+  StringAutomaton_ptr regex_auto = StringAutomatonCache::Instance().Get(cache_key);
+  if (regex_auto != nullptr) {
+    DVLOG(VLOG_LEVEL) << regex_auto->id_ << " = makeRegexAuto(" << regex << ") (cached)";
+    return regex_auto;
+  }
 
   Util::RegularExpression regular_expression (regex);
   regex_auto = StringAutomaton::makeRegexAuto(&regular_expression);
+  StringAutomatonCache::Instance().Put(cache_key, regex_auto);
 
   DVLOG(VLOG_LEVEL) << regex_auto->id_ << " = makeRegexAuto(" << regex << ")";
 
@@ -248,6 +304,13 @@ StringAutomaton_ptr StringAutomaton::makeRegexAuto(Util::RegularExpression_ptr r
   StringAutomaton_ptr regex_expr1_auto = nullptr;
   StringAutomaton_ptr regex_expr2_auto = nullptr;
 
+  if (Util::RegularExpression::Type::UNION == regular_expression->type()
+      and regular_expression->is_constant_string_union()) {
+    return StringAutomaton::makeStrings(regular_expression->constant_strings());
+  } else if (RegexCompiler::IsSupported(regular_expression)) {
+    return StringAutomaton::makeCompiledRegexAuto(regular_expression);
+  }
+
   switch (regular_expression->type()) {
   case Util::RegularExpression::Type::UNION:
     regex_expr1_auto = StringAutomaton::makeRegexAuto(regular_expression->get_expr1());
@@ -346,6 +409,130 @@ StringAutomaton_ptr StringAutomaton::makeRegexAuto(Util::RegularExpression_ptr r
   return regex_auto;
 }
 
+/**
+ * Builds the automaton of a regular expression without intersection and complement in one pass,
+ * the expression is compiled into a dfa first and only the final automaton is built with MONA.
+ * Each state uses its most frequent target as the default transition, remaining characters are
+ * stored as exceptions.
+ */
+StringAutomaton_ptr StringAutomaton::makeCompiledRegexAuto(Util::RegularExpression_ptr regular_expression) {
+  RegexCompiler regex_compiler(regular_expression);
+  regex_compiler.Compile();
+
+  IntervalDfa compiled_dfa;
+  for (int state = 0; state < regex_compiler.num_of_states(); ++state) {
+    compiled_dfa.AddState(regex_compiler.is_accepting(state));
+  }
+  for (int state = 0; state < regex_compiler.num_of_states(); ++state) {
+    for (int c = 0; c < IntervalDfa::ALPHABET_SIZE; ++c) {
+      compiled_dfa.AddTransition(state, c, c, regex_compiler.next_state(state, static_cast<unsigned char>(c)));
+    }
+  }
+  compiled_dfa.set_initial_state(0);
+
+  StringAutomaton_ptr result_auto = StringAutomaton::makeAutomaton(compiled_dfa);
+  DVLOG(VLOG_LEVEL) << result_auto->id_ << " = makeCompiledRegexAuto(" << *regular_expression << ")";
+  return result_auto;
+}
+
+/**
+ * Each state keeps its most frequent target as the default transition, remaining character
+ * intervals are split into aligned blocks so that an interval costs a few bit patterns
+ * with don't care bits instead of one exception per character
+ */
+StringAutomaton_ptr StringAutomaton::makeAutomaton(const IntervalDfa& interval_dfa) {
+  if (interval_dfa.get_initial_state() == IntervalDfa::REJECT) {
+    return StringAutomaton::makePhi();
+  }
+
+  const int num_of_variables = StringAutomaton::DEFAULT_NUM_OF_VARIABLES;
+  const int alphabet_size = 1 << num_of_variables;
+  CHECK_EQ(IntervalDfa::ALPHABET_SIZE, alphabet_size);
+
+  // mona expects the initial state to be 0, it is swapped with the interval dfa's initial state;
+  // the last state is the sink that takes all missing transitions
+  const int initial_state = interval_dfa.get_initial_state();
+  const int sink_state = interval_dfa.num_of_states();
+  const int number_of_states = sink_state + 1;
+  auto swap_initial = [initial_state, sink_state](int state) {
+    if (state == IntervalDfa::REJECT) {
+      return sink_state;
+    } else if (state == initial_state) {
+      return 0;
+    } else if (state == 0) {
+      return initial_state;
+    }
+    return state;
+  };
+
+  char* statuses = new char[number_of_states + 1];
+  int* variable_indices = getIndices(num_of_variables);
+  std::vector<int> targets(alphabet_size);
+  std::map<int, int> target_frequencies;
+  std::vector<std::pair<int, std::vector<char>>> exceptions;
+
+  dfaSetup(number_of_states, num_of_variables, variable_indices);
+  for (int mona_state = 0; mona_state < sink_state; ++mona_state) {
+    const int state = swap_initial(mona_state);
+    std::fill(targets.begin(), targets.end(), sink_state);
+    for (auto& interval : interval_dfa.get_intervals(state)) {
+      std::fill(targets.begin() + interval.first, targets.begin() + interval.last + 1, swap_initial(interval.target));
+    }
+
+    target_frequencies.clear();
+    for (int target : targets) {
+      ++target_frequencies[target];
+    }
+    auto default_target = std::max_element(target_frequencies.begin(), target_frequencies.end(),
+        [](const std::pair<const int, int>& left, const std::pair<const int, int>& right) {
+          return left.second < right.second;
+        })->first;
+
+    exceptions.clear();
+    for (int first = 0, last = 0; first < alphabet_size; first = last + 1) {
+      last = first;
+      while (last + 1 < alphabet_size and targets[last + 1] == targets[first]) {
+        ++last;
+      }
+      if (targets[first] == default_target) {
+        continue;
+      }
+      for (int c = first; c <= last;) {
+        int num_of_free_bits = 0;
+        while (num_of_free_bits < num_of_variables and (c % (1 << (num_of_free_bits + 1))) == 0
+            and c + (1 << (num_of_free_bits + 1)) - 1 <= last) {
+          ++num_of_free_bits;
+        }
+        auto binary_format = GetBinaryFormat(c, num_of_variables);
+        std::fill(binary_format.begin() + (num_of_variables - num_of_free_bits), binary_format.begin() + num_of_variables, 'X');
+        exceptions.push_back(std::make_pair(targets[first], binary_format));
+        c += (1 << num_of_free_bits);
+      }
+    }
+
+    dfaAllocExceptions(exceptions.size());
+    for (auto& exception : exceptions) {
+      dfaStoreException(exception.first, &*exception.second.begin());
+    }
+    dfaStoreState(default_target);
+    statuses[mona_state] = interval_dfa.is_accepting(state) ? '+' : '-';
+  }
+  dfaAllocExceptions(0);
+  dfaStoreState(sink_state);
+  statuses[sink_state] = '-';
+  statuses[number_of_states] = '\0';
+
+  DFA_ptr interval_mona_dfa = dfaBuild(statuses);
+  DFA_ptr result_dfa = dfaMinimize(interval_mona_dfa);
+  dfaFree(interval_mona_dfa);
+  delete[] statuses;
+  delete[] variable_indices;
+
+  StringAutomaton_ptr result_auto = new StringAutomaton(result_dfa, num_of_variables);
+  DVLOG(VLOG_LEVEL) << result_auto->id_ << " = makeAutomaton(<interval dfa with " << interval_dfa.num_of_states() << " states>)";
+  return result_auto;
+}
+
 StringAutomaton_ptr StringAutomaton::makeLengthEqual(int length, int num_of_variables) {
   StringAutomaton_ptr length_auto = nullptr;
 
@@ -493,6 +680,12 @@ StringAutomaton_ptr StringAutomaton::union_(StringAutomaton_ptr other_auto) {
   DFA_ptr union_dfa = nullptr;
   StringAutomaton_ptr union_auto = nullptr;
 
+  if (Option::Theory::USE_INTERVAL_DFA and this->isIntervalDfaConvertible() and other_auto->isIntervalDfaConvertible()) {
+    union_auto = StringAutomaton::makeAutomaton(this->toIntervalDfa().Union(other_auto->toIntervalDfa()));
+    DVLOG(VLOG_LEVEL) << union_auto->id_ << " = [" << this->id_ << "]->union(" << other_auto->id_ << ")";
+    return union_auto;
+  }
+
   union_dfa = Automaton::DfaUnion(this->dfa_, other_auto->dfa_);
 
   //  if ( this->hasEmptyString() || other_auto->hasEmptyString() ) {
@@ -512,8 +705,12 @@ StringAutomaton_ptr StringAutomaton::intersect(StringAutomaton_ptr other_auto) {
   DFA_ptr intersect_dfa = nullptr;
   StringAutomaton_ptr intersect_auto = nullptr;
 
-  intersect_dfa = Automaton::DfaIntersect(this->dfa_, other_auto->dfa_);
-  intersect_auto = new StringAutomaton(intersect_dfa, num_of_variables_);
+  if (Option::Theory::USE_INTERVAL_DFA and this->isIntervalDfaConvertible() and other_auto->isIntervalDfaConvertible()) {
+    intersect_auto = StringAutomaton::makeAutomaton(this->toIntervalDfa().Intersect(other_auto->toIntervalDfa()));
+  } else {
+    intersect_dfa = Automaton::DfaIntersect(this->dfa_, other_auto->dfa_);
+    intersect_auto = new StringAutomaton(intersect_dfa, num_of_variables_);
+  }
 
   DVLOG(VLOG_LEVEL) << intersect_auto->id_ << " = [" << this->id_ << "]->intersect(" << other_auto->id_ << ")";
 
@@ -538,8 +735,7 @@ StringAutomaton_ptr StringAutomaton::difference(StringAutomaton_ptr other_auto)
 }
 
 /**
- * Initial Re-implementation of  'dfa_concat_extrabit' in LibStranger
- *TODO Fix empty string bug that happens in case (concat /.{0,1}/ /{1,1}/)
+ * Builds the concatenation directly on the successors of both automata (see Automaton::DfaConcat)
  */
 StringAutomaton_ptr StringAutomaton::concat(StringAutomaton_ptr other_auto) {
   StringAutomaton_ptr left_auto = this, right_auto = other_auto;
@@ -552,301 +748,12 @@ StringAutomaton_ptr StringAutomaton::concat(StringAutomaton_ptr other_auto) {
     return left_auto->clone();
   }
 
-  bool left_hand_side_has_emtpy_string = left_auto->hasEmptyString();
-  bool right_hand_side_has_empty_string = right_auto->hasEmptyString();
-
-  if (left_hand_side_has_emtpy_string or right_hand_side_has_empty_string) {
-    auto any_string_other_than_empty = StringAutomaton::makeLengthGreaterThan(0);
-    if (left_hand_side_has_emtpy_string) {
-      left_auto = left_auto->intersect(any_string_other_than_empty);
-    }
-
-    if (right_hand_side_has_empty_string) {
-      right_auto = right_auto->intersect(any_string_other_than_empty);
-    }
-    delete any_string_other_than_empty;
-  }
-
-  int var = left_auto->num_of_variables_;
-  int* indices = left_auto->variable_indices_;
-  int tmp_num_of_variables,
-      state_id_shift_amount,
-      expected_num_of_states,
-      sink_state_left_auto,
-      sink_state_right_auto,
-      to_state = 0,
-      loc,
-      i = 0,
-      j = 0;
-
-  bool is_start_state_reachable;
-  paths state_paths = nullptr, pp = nullptr;
-  trace_descr tp = nullptr;
-
-  std::map<std::vector<char>*, int> exceptions_left_auto;
-  std::map<std::vector<char>*, int> exceptions_right_auto;
-  std::map<std::vector<char>*, int> exceptions_fix;
-  std::vector<char>* current_exception = nullptr;
-  char* statuses = nullptr;
-  tmp_num_of_variables = left_auto->num_of_variables_ + 1; // add one extra bit
-  state_id_shift_amount = left_auto->dfa_->ns;
-  expected_num_of_states = left_auto->dfa_->ns + right_auto->dfa_->ns;
-
-  is_start_state_reachable = right_auto->isStartStateReachableFromAnAcceptingState();
-  if (not is_start_state_reachable) {
-    expected_num_of_states = expected_num_of_states  - 1; // if start state is reachable from an accepting state, it will be merge with accepting states of left hand side
-  }
-  // variable initializations
-  sink_state_left_auto = left_auto->GetSinkState();
-  sink_state_right_auto = right_auto->GetSinkState();
-
-  bool left_sink = true, right_sink = true;
-  int sink = sink_state_left_auto;
-
-  if(sink_state_left_auto < 0 && sink_state_right_auto < 0) {
-    left_sink = right_sink = false;
-    sink = expected_num_of_states;
-    expected_num_of_states++;
-  } else if(sink_state_left_auto < 0) {
-    left_sink = false;
-    sink = sink_state_right_auto + state_id_shift_amount;
-    if(not is_start_state_reachable) {
-      sink--;
-    }
-  } else if(sink_state_right_auto < 0) {
-    right_sink = false;
-  } else {
-    expected_num_of_states--;
-  }
-
-  statuses = new char[expected_num_of_states + 1];
-  int* concat_indices = getIndices(tmp_num_of_variables);
-
-  dfaSetup(expected_num_of_states, tmp_num_of_variables, concat_indices); //sink states are merged
-  state_paths = pp = make_paths(right_auto->dfa_->bddm, right_auto->dfa_->q[right_auto->dfa_->s]);
-  while (pp) {
-    if (!right_sink || pp->to != sink_state_right_auto ) {
-      to_state = pp->to + state_id_shift_amount;
-      // if there is a self loop keep it
-      if (pp->to == (unsigned)right_auto->dfa_->s ) {
-        to_state -= 2;
-      } else {
-        if (left_sink && right_sink && pp->to > (unsigned)sink_state_right_auto ) {
-          to_state--; //to new state, sink state will be eliminated and hence need -1
-        }
-        if ((not is_start_state_reachable) && pp->to > (unsigned)right_auto->dfa_->s) {
-          to_state--; // to new state, init state will be eliminated if init is not reachable
-        }
-      }
-
-      current_exception = new std::vector<char>();
-      for (j = 0; j < right_auto->num_of_variables_; j++) {
-        //the following for loop can be avoided if the indices are in order
-        for (tp = pp->trace; tp && (tp->index != (unsigned)indices[j]); tp = tp->next);
-        if (tp) {
-          if (tp->value) {
-            current_exception->push_back('1');
-          }
-          else {
-            current_exception->push_back('0');
-          }
-        }
-        else {
-          current_exception->push_back('X');
-        }
-      }
-
-      current_exception->push_back('1'); // new path
-      current_exception->push_back('\0');
-      exceptions_right_auto[current_exception] = to_state;
-    }
-    current_exception = nullptr;
-    tp = nullptr;
-    pp = pp->next;
-  }
-
-  kill_paths(state_paths);
-  state_paths = pp = nullptr;
-
-  for (i = 0; i < left_auto->dfa_->ns; i++) {
-    state_paths = pp = make_paths(left_auto->dfa_->bddm, left_auto->dfa_->q[i]);
-    while (pp) {
-      if (left_sink && pp->to == (unsigned)sink_state_left_auto) {
-        pp = pp->next;
-        continue;
-      }
-      to_state = pp->to;
-      current_exception = new std::vector<char>();
-      for (j = 0; j < left_auto->num_of_variables_; j++) {
-        for (tp = pp->trace; tp && (tp->index != (unsigned)indices[j]); tp = tp->next);
-        if (tp) {
-          if (tp->value) {
-            current_exception->push_back('1');
-          } else {
-            current_exception->push_back('0');
-          }
-        } else {
-          current_exception->push_back('X');
-        }
-      }
-
-      current_exception->push_back('0'); // add extra bit, '0' is used for the exceptions coming from left auto
-      current_exception->push_back('\0');
-      exceptions_left_auto[current_exception] = to_state;
-      tp = nullptr;
-      pp = pp->next;
-    }
-    current_exception = nullptr;
-    // generate concat automaton
-    if (left_auto->is_accepting_state(i)) {
-      dfaAllocExceptions(exceptions_left_auto.size() + exceptions_right_auto.size());
-      for (auto it = exceptions_left_auto.begin(); it != exceptions_left_auto.end();) {
-        dfaStoreException(it->second, &*it->first->begin());
-        current_exception = it->first;
-        it = exceptions_left_auto.erase(it);
-        delete current_exception;
-      }
-      for (auto it = exceptions_right_auto.begin(); it != exceptions_right_auto.end();) {
-        dfaStoreException(it->second, &*it->first->begin());
-        current_exception = it->first;
-        it = exceptions_right_auto.erase(it);
-        delete current_exception;
-      }
-
-      dfaStoreState(sink);
-      if (right_auto->is_accepting_state(0)) {
-        statuses[i]='+';
-      }
-      else {
-        statuses[i]='-';
-      }
-    } else {
-      dfaAllocExceptions(exceptions_left_auto.size());
-      for (auto it = exceptions_left_auto.begin(); it != exceptions_left_auto.end();) {
-        dfaStoreException(it->second, &*it->first->begin());
-        current_exception = it->first;
-        it = exceptions_left_auto.erase(it);
-        delete current_exception;
-      }
-      dfaStoreState(sink);
-      statuses[i] = '-';
-    }
-    current_exception = nullptr;
-    kill_paths(state_paths);
-    state_paths = pp = nullptr;
-  }
-
-  //  initflag is 1 iff init is reached by some state. In this case,
-  for (i = 0; i < right_auto->dfa_->ns; i++) {
-    if (i != sink_state_right_auto ) {
-      if ( i != right_auto->dfa_->s || is_start_state_reachable) {
-        state_paths = pp = make_paths(right_auto->dfa_->bddm, right_auto->dfa_->q[i]);
-        while (pp) {
-          if (!right_sink || pp->to != (unsigned)sink_state_right_auto) {
-            to_state = pp->to + state_id_shift_amount;
-
-            if ( right_sink && left_sink && pp->to > (unsigned)sink_state_right_auto) {
-              to_state--; //to new state, sink state will be eliminated and hence need -1
-            }
-
-            if ( (not is_start_state_reachable) && pp->to > (unsigned)right_auto->dfa_->s) {
-              to_state--; // to new state, init state will be eliminated if init is not reachable
-            }
-
-            current_exception = new std::vector<char>();
-            for (j = 0; j < var; j++) {
-              for (tp = pp->trace; tp && (tp->index != (unsigned)indices[j]); tp =tp->next);
-              if (tp) {
-                if (tp->value){
-                  current_exception->push_back('1');
-                }
-                else {
-                  current_exception->push_back('0');
-                }
-              }
-              else {
-                current_exception->push_back('X');
-              }
-            }
-            current_exception->push_back('0'); // old value
-            current_exception->push_back('\0');
-            exceptions_fix[current_exception] = to_state;
-            tp = nullptr;
-            current_exception = nullptr;
-          }
-          pp = pp->next;
-        }
-
-        dfaAllocExceptions(exceptions_fix.size());
-        for (auto it = exceptions_fix.begin(); it != exceptions_fix.end();) {
-          dfaStoreException(it->second, &*it->first->begin());
-          current_exception = it->first;
-          it = exceptions_fix.erase(it);
-          delete current_exception;
-        }
-
-        dfaStoreState(sink);
-
-        loc = state_id_shift_amount + i;
-        if ( (not is_start_state_reachable) && i > right_auto->dfa_->s) {
-          loc--;
-        }
-        if (left_sink && right_sink && i > sink_state_right_auto) {
-          loc--;
-        }
-
-        if ( right_auto->is_accepting_state(i)) {
-          statuses[loc]='+';
-        } else {
-          statuses[loc]='-';
-        }
-
-        kill_paths(state_paths);
-        state_paths = pp = nullptr;
-      }
-    } else if(!left_sink && right_sink) {
-      dfaAllocExceptions(0);
-      dfaStoreState(sink);
-      statuses[sink] = '-';
-    }
-  }
-
-  if(!right_sink && !left_sink) {
-    dfaAllocExceptions(0);
-    dfaStoreState(sink);
-    statuses[sink] = '-';
-  }
-
-  statuses[expected_num_of_states]='\0';
-
-  DFA_ptr concat_dfa = dfaBuild(statuses);
-  delete[] statuses; statuses = nullptr;
-  delete[] concat_indices; concat_indices = nullptr;
-  DFA_ptr tmp_dfa = dfaProject(concat_dfa, (unsigned) var);
-  dfaFree(concat_dfa);
-  concat_dfa = dfaMinimize(tmp_dfa);
-  dfaFree(tmp_dfa); tmp_dfa = nullptr;
-
-  auto concat_auto = new StringAutomaton(concat_dfa, num_of_variables_);
-
-  if (left_hand_side_has_emtpy_string) {
-    auto tmp_auto = concat_auto;
-    concat_auto = tmp_auto->union_(other_auto);
-    delete tmp_auto;
-    delete left_auto; left_auto = nullptr;
-  }
-
-  if (right_hand_side_has_empty_string) {
-    auto tmp_auto = concat_auto;
-    concat_auto = tmp_auto->union_(this);
-    delete tmp_auto;
-    delete right_auto; right_auto = nullptr;
-  }
+  DFA_ptr concat_dfa = Automaton::DfaConcat(left_auto->dfa_, right_auto->dfa_, num_of_variables_, variable_indices_);
+  StringAutomaton_ptr concat_auto = new StringAutomaton(concat_dfa, num_of_variables_);
 
   DVLOG(VLOG_LEVEL) << concat_auto->id_ << " = [" << this->id_ << "]->concat(" << other_auto->id_ << ")";
 
   return concat_auto;
-
 }
 
 StringAutomaton_ptr StringAutomaton::optional() {
@@ -1299,6 +1206,7 @@ StringAutomaton_ptr StringAutomaton::suffixesFromTo(int start, int end) {
 
 StringAutomaton_ptr StringAutomaton::prefixes(){
   StringAutomaton_ptr prefix_auto = this->clone();
+  prefix_auto->DetachDFA();
   int sink_state = prefix_auto->GetSinkState();
 
 
@@ -2442,6 +2350,58 @@ std::string StringAutomaton::getAnAcceptingString() {
 //  return sharp_string_extra_bit;
 //}
 
+/**
+ * @returns true if transitions are single byte characters (no extra tracks or bits)
+ */
+bool StringAutomaton::isIntervalDfaConvertible() const {
+  return (1 << num_of_variables_) == IntervalDfa::ALPHABET_SIZE;
+}
+
+/**
+ * Reads the bdd of each state into a byte table, bdd variables skipped on a path are
+ * don't care bits, the sink state becomes the implicit reject of the interval dfa
+ */
+IntervalDfa StringAutomaton::toIntervalDfa() {
+  CHECK(isIntervalDfaConvertible()) << "interval dfa needs " << IntervalDfa::ALPHABET_SIZE << " letter alphabet";
+  IntervalDfa interval_dfa;
+  std::vector<int> state_ids(this->dfa_->ns, IntervalDfa::REJECT);
+  for (int s = 0; s < this->dfa_->ns; ++s) {
+    if (not isSinkState(s)) {
+      state_ids[s] = interval_dfa.AddState(is_accepting_state(s));
+    }
+  }
+  interval_dfa.set_initial_state(state_ids[this->dfa_->s]);
+
+  std::vector<int> targets(IntervalDfa::ALPHABET_SIZE);
+  std::function<void(unsigned, int, int)> read_bdd = [&](unsigned p, int prefix, int depth) {
+    unsigned l, r, index;
+    LOAD_lri(&this->dfa_->bddm->node_table[p], l, r, index);
+    if (index == BDD_LEAF_INDEX) {
+      const int free_bits = num_of_variables_ - depth;
+      std::fill(targets.begin() + (prefix << free_bits), targets.begin() + ((prefix + 1) << free_bits), state_ids[l]);
+    } else if (static_cast<int>(index) > depth) {
+      read_bdd(p, prefix << 1, depth + 1);
+      read_bdd(p, (prefix << 1) | 1, depth + 1);
+    } else {
+      read_bdd(l, prefix << 1, depth + 1);
+      read_bdd(r, (prefix << 1) | 1, depth + 1);
+    }
+  };
+
+  for (int s = 0; s < this->dfa_->ns; ++s) {
+    if (state_ids[s] == IntervalDfa::REJECT) {
+      continue;
+    }
+    read_bdd(this->dfa_->q[s], 0, 0);
+    for (int c = 0; c < IntervalDfa::ALPHABET_SIZE; ++c) {
+      interval_dfa.AddTransition(state_ids[s], c, c, targets[c]);
+    }
+  }
+
+  DVLOG(VLOG_LEVEL) << "[" << this->id_ << "]->toIntervalDfa() has " << interval_dfa.num_of_states() << " states";
+  return interval_dfa;
+}
+
 /**
  * @returns true if state has the given exception to a state that is not sink
  */
@@ -2498,6 +2458,7 @@ StringAutomaton_ptr StringAutomaton::indexOfHelper(StringAutomaton_ptr search_au
   std::stack<int> state_work_list;
   std::map<int, bool> visited;
 
+  index_of_auto->DetachDFA();
   for (int s = 0; s < index_of_auto->dfa_->ns; s++) {
     index_of_auto->dfa_->f[s] = -1;
   }
@@ -2579,6 +2540,7 @@ StringAutomaton_ptr StringAutomaton::lastIndexOfHelper(StringAutomaton_ptr searc
   graph->resetFinalNodesToFlag(3);
 
   // BEGIN generate automaton
+  search_result_auto->DetachDFA();
   for (int s = 0; s < search_result_auto->dfa_->ns; s++) {
     GraphNode_ptr node = graph->getNode(s);
     if (graph->isFinalNode(node)) {
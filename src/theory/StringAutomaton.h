@@ -8,6 +8,7 @@
 #ifndef THEORY_STRINGAUTOMATON_H_
 #define THEORY_STRINGAUTOMATON_H_
 
+#include <atomic>
 #include <cmath>
 #include <cstring>
 #include <iterator>
@@ -29,7 +30,11 @@
 #include "Graph.h"
 #include "GraphNode.h"
 #include "IntAutomaton.h"
+#include "IntervalDfa.h"
 #include "MultiTrackAutomaton.h"
+#include "RegexCompiler.h"
+#include "StringAutomatonCache.h"
+#include "StringSetCompiler.h"
 
 namespace Vlab {
 namespace Theory {
@@ -54,6 +59,7 @@ public:
   static StringAutomaton_ptr makePhi(int num_of_variables = StringAutomaton::DEFAULT_NUM_OF_VARIABLES);
   static StringAutomaton_ptr makeEmptyString(int num_of_variables = StringAutomaton::DEFAULT_NUM_OF_VARIABLES);
   static StringAutomaton_ptr makeString(std::string str, int num_of_variables = StringAutomaton::DEFAULT_NUM_OF_VARIABLES);
+  static StringAutomaton_ptr makeStrings(const std::vector<std::string>& strs, int num_of_variables = StringAutomaton::DEFAULT_NUM_OF_VARIABLES);
   static StringAutomaton_ptr makeAnyString(int num_of_variables = StringAutomaton::DEFAULT_NUM_OF_VARIABLES);
   static StringAutomaton_ptr makeAnyStringOtherThan(std::string str, int num_of_variables = StringAutomaton::DEFAULT_NUM_OF_VARIABLES);
   static StringAutomaton_ptr makeChar(char c, int num_of_variables = StringAutomaton::DEFAULT_NUM_OF_VARIABLES);
@@ -147,9 +153,15 @@ public:
   std::string getAnAcceptingString();
   bool has_sharp_bit() const {return sharp_bit_;}
 
+  static thread_local int DEFAULT_NUM_OF_VARIABLES;
 protected:
 
   static StringAutomaton_ptr makeRegexAuto(Util::RegularExpression_ptr regular_expression);
+  static StringAutomaton_ptr makeCompiledRegexAuto(Util::RegularExpression_ptr regular_expression);
+  static StringAutomaton_ptr makeAutomaton(const IntervalDfa& interval_dfa);
+
+  bool isIntervalDfaConvertible() const;
+  IntervalDfa toIntervalDfa();
 
   // TODO figure out better name
 //  static StringAutomaton_ptr dfaSharpStringWithExtraBit(int num_of_variables = StringAutomaton::DEFAULT_NUM_OF_VARIABLES,
@@ -165,11 +177,10 @@ protected:
   StringAutomaton_ptr search(StringAutomaton_ptr search_auto, bool use_extra_bit = false);
   StringAutomaton_ptr removeReservedWords();
 
-  static int DEFAULT_NUM_OF_VARIABLES;
   bool sharp_bit_;
 
 private:
-  static int name_counter;
+  static std::atomic<int> name_counter;
   static const int VLOG_LEVEL;
 };
 
@@ -0,0 +1,106 @@
+/*
+ * StringAutomatonCache.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "StringAutomatonCache.h"
+
+#include "StringAutomaton.h"
+
+namespace Vlab {
+namespace Theory {
+
+const int StringAutomatonCache::VLOG_LEVEL = 12;
+
+const std::size_t StringAutomatonCache::DEFAULT_CAPACITY = 256;
+
+StringAutomatonCache& StringAutomatonCache::Instance() {
+  static StringAutomatonCache instance;
+  return instance;
+}
+
+std::string StringAutomatonCache::MakeRegexKey(const std::string& regex, int syntax_flags, int num_of_variables) {
+  return "r" + std::to_string(syntax_flags) + ":" + std::to_string(num_of_variables) + ":" + regex;
+}
+
+std::string StringAutomatonCache::MakeStringKey(const std::string& str, int num_of_variables) {
+  return "s" + std::to_string(num_of_variables) + ":" + str;
+}
+
+StringAutomatonCache::StringAutomatonCache()
+    : capacity_(DEFAULT_CAPACITY),
+      num_of_hits_(0),
+      num_of_misses_(0) {
+}
+
+StringAutomatonCache::~StringAutomatonCache() {
+  Clear();
+}
+
+StringAutomaton_ptr StringAutomatonCache::Get(const std::string& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    ++num_of_misses_;
+    return nullptr;
+  }
+  ++num_of_hits_;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->second->clone();
+}
+
+void StringAutomatonCache::Put(const std::string& key, const StringAutomaton_ptr automaton) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (capacity_ == 0 or index_.find(key) != index_.end()) {
+    return;
+  }
+  EvictUntil(capacity_ - 1);
+  entries_.push_front(std::make_pair(key, automaton->clone()));
+  index_[key] = entries_.begin();
+}
+
+void StringAutomatonCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  EvictUntil(0);
+}
+
+void StringAutomatonCache::set_capacity(std::size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  EvictUntil(capacity_);
+}
+
+std::size_t StringAutomatonCache::capacity() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return capacity_;
+}
+
+std::size_t StringAutomatonCache::size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+unsigned long StringAutomatonCache::num_of_hits() const {
+  return num_of_hits_;
+}
+
+unsigned long StringAutomatonCache::num_of_misses() const {
+  return num_of_misses_;
+}
+
+void StringAutomatonCache::EvictUntil(std::size_t size) {
+  while (entries_.size() > size) {
+    DVLOG(VLOG_LEVEL) << "evict: " << entries_.back().first;
+    delete entries_.back().second;
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+}
+
+} /* namespace Theory */
+} /* namespace Vlab */
@@ -0,0 +1,84 @@
+/*
+ * StringAutomatonCache.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SRC_THEORY_STRINGAUTOMATONCACHE_H_
+#define SRC_THEORY_STRINGAUTOMATONCACHE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <glog/logging.h>
+
+namespace Vlab {
+namespace Theory {
+
+class StringAutomaton;
+typedef StringAutomaton* StringAutomaton_ptr;
+
+/**
+ * Process wide least recently used cache of automata built from regular expression and
+ * string constants. The cache owns its automata and only hands out clones.
+ * Callers build keys with MakeRegexKey/MakeStringKey, the regex key includes the regex
+ * syntax flags since the same text parses differently under different flags.
+ */
+class StringAutomatonCache {
+ public:
+  static const std::size_t DEFAULT_CAPACITY;
+
+  static StringAutomatonCache& Instance();
+
+  static std::string MakeRegexKey(const std::string& regex, int syntax_flags, int num_of_variables);
+  static std::string MakeStringKey(const std::string& str, int num_of_variables);
+
+  /**
+   * @returns a clone of the cached automaton, nullptr on a miss
+   */
+  StringAutomaton_ptr Get(const std::string& key);
+
+  /**
+   * Caches a clone of the automaton, evicts the least recently used entry when full
+   */
+  void Put(const std::string& key, const StringAutomaton_ptr automaton);
+
+  void Clear();
+  void set_capacity(std::size_t capacity);
+  std::size_t capacity();
+  std::size_t size();
+  unsigned long num_of_hits() const;
+  unsigned long num_of_misses() const;
+
+ protected:
+  StringAutomatonCache();
+  ~StringAutomatonCache();
+  void EvictUntil(std::size_t size);
+
+  using Entry = std::pair<std::string, StringAutomaton_ptr>;
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  std::size_t capacity_;
+  std::mutex mutex_;
+  std::atomic<unsigned long> num_of_hits_;
+  std::atomic<unsigned long> num_of_misses_;
+
+ private:
+  StringAutomatonCache(const StringAutomatonCache&) = delete;
+  StringAutomatonCache& operator=(const StringAutomatonCache&) = delete;
+  static const int VLOG_LEVEL;
+};
+
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* SRC_THEORY_STRINGAUTOMATONCACHE_H_ */
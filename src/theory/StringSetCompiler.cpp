@@ -0,0 +1,139 @@
+/*
+ * StringSetCompiler.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "StringSetCompiler.h"
+
+namespace Vlab {
+namespace Theory {
+
+const int StringSetCompiler::VLOG_LEVEL = 20;
+
+StringSetCompiler::StringSetCompiler(std::vector<std::string> strings)
+    : strings_(std::move(strings)) {
+}
+
+StringSetCompiler::~StringSetCompiler() {
+}
+
+void StringSetCompiler::Compile() {
+  // compare as unsigned characters, transitions are ordered the same way
+  std::sort(strings_.begin(), strings_.end(), [](const std::string& left, const std::string& right) {
+    return std::lexicographical_compare(left.begin(), left.end(), right.begin(), right.end(),
+        [](char l, char r) {return static_cast<unsigned char>(l) < static_cast<unsigned char>(r);});
+  });
+  strings_.erase(std::unique(strings_.begin(), strings_.end()), strings_.end());
+
+  states_.clear();
+  register_.clear();
+  AddState();
+  for (auto& str : strings_) {
+    AddString(str);
+  }
+  if (not states_[0].transitions.empty()) {
+    ReplaceOrRegister(0);
+  }
+  Renumber();
+  register_.clear();
+
+  DVLOG(VLOG_LEVEL) << "string set compiled, strings: " << strings_.size() << ", states: " << states_.size();
+}
+
+int StringSetCompiler::num_of_states() const {
+  return states_.size();
+}
+
+bool StringSetCompiler::is_accepting(const int state) const {
+  return states_[state].is_accepting;
+}
+
+const StringSetCompiler::TransitionMap& StringSetCompiler::get_transitions(const int state) const {
+  return states_[state].transitions;
+}
+
+int StringSetCompiler::AddState() {
+  states_.push_back(State {false, TransitionMap()});
+  return states_.size() - 1;
+}
+
+void StringSetCompiler::AddString(const std::string& str) {
+  int state = 0;
+  std::size_t i = 0;
+  for (; i < str.length(); ++i) {
+    auto it = states_[state].transitions.find(static_cast<unsigned char>(str[i]));
+    if (it == states_[state].transitions.end()) {
+      break;
+    }
+    state = it->second;
+  }
+
+  if (not states_[state].transitions.empty()) {
+    ReplaceOrRegister(state);
+  }
+
+  for (; i < str.length(); ++i) {
+    int next_state = AddState();
+    states_[state].transitions[static_cast<unsigned char>(str[i])] = next_state;
+    state = next_state;
+  }
+  states_[state].is_accepting = true;
+}
+
+/**
+ * Minimizes the path below the last transition of the state, states on that path are final
+ * since strings are added in order
+ */
+void StringSetCompiler::ReplaceOrRegister(const int state) {
+  auto& last_transition = *states_[state].transitions.rbegin();
+  int child = last_transition.second;
+  if (not states_[child].transitions.empty()) {
+    ReplaceOrRegister(child);
+  }
+
+  auto signature = std::make_pair(states_[child].is_accepting,
+      std::vector<std::pair<unsigned char, int>>(states_[child].transitions.begin(), states_[child].transitions.end()));
+  auto it = register_.find(signature);
+  if (it == register_.end()) {
+    register_[signature] = child;
+  } else {
+    // replaced state stays unreachable and is dropped by Renumber
+    states_[state].transitions[last_transition.first] = it->second;
+  }
+}
+
+/**
+ * Drops unreachable states and numbers the remaining ones in breadth first order
+ */
+void StringSetCompiler::Renumber() {
+  std::vector<int> new_ids(states_.size(), -1);
+  std::vector<int> order {0};
+  new_ids[0] = 0;
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    for (auto& transition : states_[order[i]].transitions) {
+      if (new_ids[transition.second] == -1) {
+        new_ids[transition.second] = order.size();
+        order.push_back(transition.second);
+      }
+    }
+  }
+
+  std::vector<State> states;
+  states.reserve(order.size());
+  for (int old_id : order) {
+    State state {states_[old_id].is_accepting, TransitionMap()};
+    for (auto& transition : states_[old_id].transitions) {
+      state.transitions[transition.first] = new_ids[transition.second];
+    }
+    states.push_back(std::move(state));
+  }
+  states_ = std::move(states);
+}
+
+} /* namespace Theory */
+} /* namespace Vlab */
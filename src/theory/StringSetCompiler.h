@@ -0,0 +1,66 @@
+/*
+ * StringSetCompiler.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SRC_THEORY_STRINGSETCOMPILER_H_
+#define SRC_THEORY_STRINGSETCOMPILER_H_
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glog/logging.h>
+
+namespace Vlab {
+namespace Theory {
+
+/**
+ * Builds the minimal acyclic dfa of a finite set of strings with the incremental
+ * construction of Daciuk et al. Strings are added in lexicographic order, so only the
+ * path of the last added string is not minimized yet; the states that leave that path are
+ * merged with an equivalent registered state or registered themselves.
+ * State 0 is the initial state, missing transitions go to an implicit sink state.
+ */
+class StringSetCompiler {
+ public:
+  using TransitionMap = std::map<unsigned char, int>;
+
+  StringSetCompiler(std::vector<std::string> strings);
+  virtual ~StringSetCompiler();
+
+  void Compile();
+  int num_of_states() const;
+  bool is_accepting(const int state) const;
+  const TransitionMap& get_transitions(const int state) const;
+
+ protected:
+  struct State {
+    bool is_accepting;
+    TransitionMap transitions;
+  };
+
+  int AddState();
+  void AddString(const std::string& str);
+  void ReplaceOrRegister(const int state);
+  void Renumber();
+
+  std::vector<std::string> strings_;
+  std::vector<State> states_;
+  std::map<std::pair<bool, std::vector<std::pair<unsigned char, int>>>, int> register_;
+
+ private:
+  static const int VLOG_LEVEL;
+};
+
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* SRC_THEORY_STRINGSETCOMPILER_H_ */
@@ -12,7 +12,8 @@ namespace Theory {
 
 const int SymbolicCounter::VLOG_LEVEL = 9;
 
-SymbolicCounter::SymbolicCounter() : type_(SymbolicCounter::Type::STRING), bound_(0) {
+SymbolicCounter::SymbolicCounter() : type_(SymbolicCounter::Type::STRING), bound_(0), is_recurrence_cached_{false},
+      is_native_matrix_cached_{false}, is_native_matrix_valid_{false} {
 
 }
 
@@ -49,68 +50,386 @@ Eigen::SparseMatrix<BigInteger> SymbolicCounter::get_transition_count_matrix() c
 
 void SymbolicCounter::set_transition_count_matrix(const Eigen::SparseMatrix<BigInteger>& transition_count_matrix) {
   transition_count_matrix_ = transition_count_matrix;
+  ClearCache();
 }
 
+/**
+ * Advances the cached initialization vector from the last counted bound.
+ * Gaps are walked one sparse matrix-vector product at a time unless the cached powers of the
+ * transition count matrix (O(log gap) products) are estimated to be cheaper, see UseMatrixPowers.
+ */
 BigInteger SymbolicCounter::Count(const unsigned long bound) {
-  unsigned long power = bound;
+  const unsigned long power = GetPower(bound);
+
+  if (power < bound_) {
+    initialization_vector_ = transition_count_matrix_.innerVector(transition_count_matrix_.cols()-1);
+    bound_ = 0;
+  }
+
+  unsigned long remaining = power - bound_;
+  if (UseMatrixPowers(remaining)) {
+    MultiplyByPower(initialization_vector_, remaining);
+  } else {
+    AdvanceNative(remaining); // leaves the remaining steps to BigInteger arithmetic on overflow
+    while (remaining > 0) {
+      initialization_vector_ = transition_count_matrix_ * initialization_vector_;
+      --remaining;
+    }
+  }
+
+  bound_ = power;
+
+  DVLOG(VLOG_LEVEL) << "Count(" << bound << ") = " << initialization_vector_.coeff(0);
+  return initialization_vector_.coeff(0);
+}
 
+/**
+ * Counts all bounds in one forward sweep over the initialization vector, bounds are visited in
+ * increasing order so that no prefix is recomputed, results are in the order of the given bounds
+ */
+std::vector<BigInteger> SymbolicCounter::Count(const std::vector<unsigned long>& bounds) {
+  std::vector<std::size_t> order(bounds.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this, &bounds](const std::size_t i, const std::size_t j) {
+    return GetPower(bounds[i]) < GetPower(bounds[j]);
+  });
+
+  std::vector<BigInteger> counts(bounds.size());
+  for (const auto i : order) {
+    counts[i] = Count(bounds[i]);
+  }
+  return counts;
+}
+
+/**
+ * Counting with matrix exponentiation by successive squaring,
+ * does not modify the cached initialization vector
+ */
+BigInteger SymbolicCounter::CountbyMatrixMultiplication(const unsigned long bound) {
+  // initialization vector is already one multiplication away because of artificial accepting state
+  Eigen::SparseVector<BigInteger> count_vector = transition_count_matrix_.innerVector(transition_count_matrix_.cols()-1);
+  MultiplyByPower(count_vector, GetPower(bound));
+
+  DVLOG(VLOG_LEVEL) << "CountbyMatrixMultiplication(" << bound << ") = " << count_vector.coeff(0);
+  return count_vector.coeff(0);
+}
+
+/**
+ * Counting with the linear recurrence of the count sequence (closed form of the generating function),
+ * evaluates a bound with O(d^2 log bound) arithmetic operations where d is the order of the recurrence
+ */
+BigInteger SymbolicCounter::CountbyRecurrence(const unsigned long bound) {
+  if (not is_recurrence_cached_) {
+    ComputeRecurrence();
+  }
+
+  const unsigned long power = GetPower(bound);
+  if (power < recurrence_initial_terms_.size()) {
+    DVLOG(VLOG_LEVEL) << "CountbyRecurrence(" << bound << ") = " << recurrence_initial_terms_[power];
+    return recurrence_initial_terms_[power];
+  }
+
+  const std::size_t order = recurrence_.size();
+  if (order == 0) {
+    DVLOG(VLOG_LEVEL) << "CountbyRecurrence(" << bound << ") = 0";
+    return 0;
+  }
+
+  // x^power mod characteristic polynomial, by successive squaring
+  std::vector<BigInteger> result(order, 0), base(order, 0);
+  result[0] = 1;
+  if (order == 1) {
+    base[0] = recurrence_[0];
+  } else {
+    base[1] = 1;
+  }
+  for (unsigned long p = power; p > 0; p >>= 1) {
+    if (p & 1UL) {
+      result = MultiplyModRecurrence(result, base);
+    }
+    if (p > 1) {
+      base = MultiplyModRecurrence(base, base);
+    }
+  }
+
+  BigInteger count = 0;
+  for (std::size_t i = 0; i < order; ++i) {
+    count += result[i] * recurrence_initial_terms_[i];
+  }
+
+  DVLOG(VLOG_LEVEL) << "CountbyRecurrence(" << bound << ") = " << count;
+  return count;
+}
+
+/**
+ * Drops everything derived from the transition count matrix
+ */
+void SymbolicCounter::ClearCache() {
+  transition_count_matrix_powers_.clear();
+  is_recurrence_cached_ = false;
+  recurrence_.clear();
+  recurrence_initial_terms_.clear();
+  is_native_matrix_cached_ = false;
+  is_native_matrix_valid_ = false;
+  native_outer_index_.clear();
+  native_inner_index_.clear();
+  native_values_.clear();
+}
+
+/**
+ * @returns number of transitions needed to count up to the given bound
+ */
+unsigned long SymbolicCounter::GetPower(const unsigned long bound) const {
+  unsigned long power = bound;
   if (SymbolicCounter::Type::BINARYINT == type_) {
     ++power; // handle sign bit
   } else if (SymbolicCounter::Type::UNARYINT == type_) {
     unsigned long base = 1;
     power = (base << bound) - 1;
   }
+  return power;
+}
 
-  if (power >= bound_) {
-    power = power - bound_;
-  } else {
-    initialization_vector_ = transition_count_matrix_.innerVector(transition_count_matrix_.cols()-1);
+/**
+ * Advances initialization vector with fixed width arithmetic, one transition at a time, and
+ * decrements remaining for each step taken. Stops before the first step that overflows.
+ * @returns true if all remaining steps are taken
+ */
+bool SymbolicCounter::AdvanceNative(unsigned long& remaining) {
+  if (not is_native_matrix_cached_) {
+    SetNativeTransitionCountMatrix();
   }
 
-  while (power > 0) {
-    initialization_vector_ = transition_count_matrix_ * initialization_vector_;
-    --power;
+  if (not is_native_matrix_valid_) {
+    return false;
   }
 
-  bound_ = bound;
-  if (SymbolicCounter::Type::BINARYINT == type_) {
-    ++bound_; // handle sign bit
+  const std::size_t size = static_cast<std::size_t>(initialization_vector_.size());
+  std::vector<NativeCount> current(size, 0), next(size, 0);
+  for (Eigen::SparseVector<BigInteger>::InnerIterator it(initialization_vector_); it; ++it) {
+    if (not ToNativeCount(it.value(), current[it.index()])) {
+      return false;
+    }
   }
 
-  DVLOG(VLOG_LEVEL) << "Count(" << bound << ") = " << initialization_vector_.coeff(0);
-  return initialization_vector_.coeff(0);
+  const unsigned long requested = remaining;
+  bool is_overflow = false;
+  while (remaining > 0 and (not is_overflow)) {
+    std::fill(next.begin(), next.end(), 0);
+    for (std::size_t col = 0; col < size and (not is_overflow); ++col) {
+      if (current[col] == 0) {
+        continue;
+      }
+      for (std::size_t k = native_outer_index_[col]; k < native_outer_index_[col + 1]; ++k) {
+        NativeCount product = 0;
+        const std::size_t row = native_inner_index_[k];
+        if (__builtin_mul_overflow(native_values_[k], current[col], &product)
+            or __builtin_add_overflow(next[row], product, &next[row])) {
+          is_overflow = true;
+          break;
+        }
+      }
+    }
+
+    if (not is_overflow) {
+      current.swap(next);
+      --remaining;
+    }
+  }
+
+  if (remaining != requested) {
+    Eigen::SparseVector<BigInteger> vector(initialization_vector_.size());
+    for (std::size_t i = 0; i < size; ++i) {
+      if (current[i] != 0) {
+        vector.insert(i) = FromNativeCount(current[i]);
+      }
+    }
+    initialization_vector_ = vector;
+  }
+
+  DVLOG(VLOG_LEVEL) << "fixed width steps: " << requested - remaining << "/" << requested;
+  return not is_overflow;
 }
 
-BigInteger SymbolicCounter::CountbyMatrixMultiplication(const unsigned long bound) {
-  LOG(FATAL) << "not fixed yet";
-  return 0;
-  //  // matrix exponentiation is off by 1 because of artificial accepting state
-//  int power = bound + 1;
-//
-//  Eigen::SparseMatrix<BigInteger> y;
-//  bool has_odds = false;
-//
-//  while (power > 1) {
-//    if (power % 2 == 0) {
-//      power = power / 2;
-//    } else {
-//      power = (power - 1) / 2;
-//      if (has_odds) {
-//        y = x * y;
-//      } else {
-//        y = x;
-//        has_odds = true;
-//      }
-//    }
-//    x = x * x;
-//  }
-//
-//  if (has_odds) {
-//    x = x * y;
-//  }
-//
-//  BigInteger result = x.coeff(this->dfa_->s, this->dfa_->ns);
-//  return result;
+void SymbolicCounter::SetNativeTransitionCountMatrix() {
+  is_native_matrix_cached_ = true;
+  is_native_matrix_valid_ = true;
+  native_outer_index_.assign(1, 0);
+  native_inner_index_.clear();
+  native_values_.clear();
+  for (Eigen::Index col = 0; col < transition_count_matrix_.outerSize(); ++col) {
+    for (Eigen::SparseMatrix<BigInteger>::InnerIterator it(transition_count_matrix_, col); it; ++it) {
+      NativeCount value = 0;
+      if (not ToNativeCount(it.value(), value)) {
+        is_native_matrix_valid_ = false;
+        native_outer_index_.clear();
+        native_inner_index_.clear();
+        native_values_.clear();
+        return;
+      }
+      native_inner_index_.push_back(static_cast<std::size_t>(it.row()));
+      native_values_.push_back(value);
+    }
+    native_outer_index_.push_back(native_values_.size());
+  }
+}
+
+bool SymbolicCounter::ToNativeCount(const BigInteger& value, NativeCount& native_value) {
+  if (value < 0 or (value != 0 and boost::multiprecision::msb(value) >= 128)) {
+    return false;
+  }
+  const BigInteger low_mask = std::numeric_limits<unsigned long long>::max();
+  native_value = static_cast<NativeCount>((value >> 64).convert_to<unsigned long long>()) << 64;
+  native_value |= static_cast<NativeCount>((value & low_mask).convert_to<unsigned long long>());
+  return true;
+}
+
+BigInteger SymbolicCounter::FromNativeCount(const NativeCount native_value) {
+  BigInteger value = static_cast<unsigned long long>(native_value >> 64);
+  value <<= 64;
+  value |= static_cast<unsigned long long>(native_value);
+  return value;
+}
+
+/**
+ * Powers of the transition count matrix get dense after a few squarings, so each missing power
+ * costs about n^3 products and each cached one about n^2, while walking the gap costs one
+ * product per nonzero of the matrix per step
+ */
+bool SymbolicCounter::UseMatrixPowers(const unsigned long remaining) const {
+  if (remaining == 0) {
+    return false;
+  }
+  const long double n = transition_count_matrix_.cols();
+  const long double nnz = std::max<long double>(transition_count_matrix_.nonZeros(), 1);
+  std::size_t num_of_powers = 0;
+  for (unsigned long p = remaining; p > 0; p >>= 1) {
+    ++num_of_powers;
+  }
+  const std::size_t num_of_missing_powers =
+      (num_of_powers > transition_count_matrix_powers_.size()) ? num_of_powers - transition_count_matrix_powers_.size() : 0;
+  const long double squaring_cost = num_of_missing_powers * n * n * n + num_of_powers * n * n;
+  const long double walking_cost = remaining * nnz;
+  return squaring_cost < walking_cost;
+}
+
+/**
+ * Multiplies vector with transition_count_matrix_^power using the binary expansion of power
+ */
+void SymbolicCounter::MultiplyByPower(Eigen::SparseVector<BigInteger>& vector, unsigned long power) {
+  for (std::size_t exponent = 0; power > 0; ++exponent, power >>= 1) {
+    if (power & 1UL) {
+      vector = GetPowerOfTwo(exponent) * vector;
+    }
+  }
+}
+
+const Eigen::SparseMatrix<BigInteger>& SymbolicCounter::GetPowerOfTwo(const std::size_t exponent) {
+  if (transition_count_matrix_powers_.empty()) {
+    transition_count_matrix_powers_.push_back(transition_count_matrix_);
+  }
+
+  while (transition_count_matrix_powers_.size() <= exponent) {
+    Eigen::SparseMatrix<BigInteger> square = transition_count_matrix_powers_.back() * transition_count_matrix_powers_.back();
+    square.makeCompressed();
+    transition_count_matrix_powers_.push_back(square);
+    DVLOG(VLOG_LEVEL) << "cached transition count matrix power 2^" << transition_count_matrix_powers_.size() - 1;
+  }
+
+  return transition_count_matrix_powers_[exponent];
+}
+
+/**
+ * Count sequence satisfies the characteristic polynomial of the transition count matrix,
+ * det(I - tA) is the denominator of its generating function. Instead of symbolic determinants,
+ * the minimal recurrence is recovered with Berlekamp-Massey from the first 2n terms of the sequence
+ * (n is the size of the matrix). Minimal recurrence of an integer sequence with a monic integer
+ * recurrence has integer coefficients.
+ */
+void SymbolicCounter::ComputeRecurrence() {
+  using Rational = boost::multiprecision::cpp_rational;
+  const std::size_t num_of_terms = 2 * static_cast<std::size_t>(transition_count_matrix_.cols());
+
+  recurrence_initial_terms_.clear();
+  Eigen::SparseVector<BigInteger> count_vector = transition_count_matrix_.innerVector(transition_count_matrix_.cols()-1);
+  for (std::size_t i = 0; i < num_of_terms; ++i) {
+    if (i > 0) {
+      count_vector = transition_count_matrix_ * count_vector;
+    }
+    recurrence_initial_terms_.push_back(count_vector.coeff(0));
+  }
+
+  std::vector<Rational> connection {1}, previous_connection {1};
+  Rational previous_discrepancy = 1;
+  std::size_t length = 0, shift = 1;
+  for (std::size_t n = 0; n < num_of_terms; ++n) {
+    Rational discrepancy = recurrence_initial_terms_[n];
+    for (std::size_t i = 1; i <= length and i < connection.size(); ++i) {
+      discrepancy += connection[i] * recurrence_initial_terms_[n - i];
+    }
+    if (discrepancy == 0) {
+      ++shift;
+      continue;
+    }
+
+    std::vector<Rational> updated_connection = connection;
+    const Rational factor = discrepancy / previous_discrepancy;
+    if (updated_connection.size() < previous_connection.size() + shift) {
+      updated_connection.resize(previous_connection.size() + shift, 0);
+    }
+    for (std::size_t i = 0; i < previous_connection.size(); ++i) {
+      updated_connection[i + shift] -= factor * previous_connection[i];
+    }
+
+    if (2 * length <= n) {
+      previous_connection = connection;
+      previous_discrepancy = discrepancy;
+      length = n + 1 - length;
+      shift = 1;
+    } else {
+      ++shift;
+    }
+    connection = updated_connection;
+  }
+
+  connection.resize(length + 1, 0);
+  recurrence_.clear();
+  for (std::size_t i = 1; i <= length; ++i) {
+    CHECK(boost::multiprecision::denominator(connection[i]) == 1) << "non-integer recurrence coefficient: " << connection[i];
+    recurrence_.push_back(-boost::multiprecision::numerator(connection[i]));
+  }
+
+  is_recurrence_cached_ = true;
+  DVLOG(VLOG_LEVEL) << "recurrence order: " << recurrence_.size() << " (matrix size: " << transition_count_matrix_.cols() << ")";
+}
+
+/**
+ * Multiplies two polynomials of degree less than the recurrence order modulo the characteristic polynomial
+ * x^d - sum_i recurrence_[i] * x^(d - 1 - i)
+ */
+std::vector<BigInteger> SymbolicCounter::MultiplyModRecurrence(const std::vector<BigInteger>& x, const std::vector<BigInteger>& y) const {
+  const std::size_t order = recurrence_.size();
+  std::vector<BigInteger> product(2 * order - 1, 0);
+  for (std::size_t i = 0; i < order; ++i) {
+    if (x[i] == 0) {
+      continue;
+    }
+    for (std::size_t j = 0; j < order; ++j) {
+      product[i + j] += x[i] * y[j];
+    }
+  }
+
+  for (std::size_t k = product.size() - 1; k >= order; --k) {
+    if (product[k] == 0) {
+      continue;
+    }
+    for (std::size_t i = 0; i < order; ++i) {
+      product[k - 1 - i] += product[k] * recurrence_[i];
+    }
+  }
+
+  product.resize(order);
+  return product;
 }
 
 std::string SymbolicCounter::str() const {
@@ -8,9 +8,13 @@
 #ifndef SRC_THEORY_SYMBOLICCOUNTER_H_
 #define SRC_THEORY_SYMBOLICCOUNTER_H_
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <glog/logging.h>
 
@@ -38,7 +42,9 @@ class SymbolicCounter {
   void set_transition_count_matrix(const Eigen::SparseMatrix<BigInteger>& transition_count_matrix);
 
   BigInteger Count(const unsigned long bound);
+  std::vector<BigInteger> Count(const std::vector<unsigned long>& bounds);
   BigInteger CountbyMatrixMultiplication(const unsigned long bound);
+  BigInteger CountbyRecurrence(const unsigned long bound);
 
   template <class Archive>
   void save(Archive& ar) const {
@@ -56,15 +62,57 @@ class SymbolicCounter {
     ar(bound_);
     Util::Serialize::load(ar, initialization_vector_);
     Util::Serialize::load(ar, transition_count_matrix_);
+    ClearCache();
   }
 
   std::string str() const;
   friend std::ostream& operator<<(std::ostream& os, const SymbolicCounter& sc);
 protected:
+  /**
+   * Fixed width count type used before falling back to BigInteger arithmetic
+   */
+  using NativeCount = unsigned __int128;
+
+  void ClearCache();
+  unsigned long GetPower(const unsigned long bound) const;
+  bool AdvanceNative(unsigned long& remaining);
+  void SetNativeTransitionCountMatrix();
+  static bool ToNativeCount(const BigInteger& value, NativeCount& native_value);
+  static BigInteger FromNativeCount(const NativeCount native_value);
+  bool UseMatrixPowers(const unsigned long remaining) const;
+  void MultiplyByPower(Eigen::SparseVector<BigInteger>& vector, unsigned long power);
+  const Eigen::SparseMatrix<BigInteger>& GetPowerOfTwo(const std::size_t exponent);
+  void ComputeRecurrence();
+  std::vector<BigInteger> MultiplyModRecurrence(const std::vector<BigInteger>& x, const std::vector<BigInteger>& y) const;
+
   Type type_;
+  /**
+   * Number of transitions the initialization vector has been advanced by
+   */
   unsigned long bound_;
   Eigen::SparseVector<BigInteger> initialization_vector_;
   Eigen::SparseMatrix<BigInteger> transition_count_matrix_;
+  /**
+   * transition_count_matrix_powers_[i] is transition_count_matrix_ to the power of 2^i,
+   * computed on demand and reused across bounds (not serialized)
+   */
+  std::vector<Eigen::SparseMatrix<BigInteger>> transition_count_matrix_powers_;
+  /**
+   * Linear recurrence of the count sequence, term(p) = sum_i recurrence_[i] * term(p - 1 - i),
+   * and the first terms of the sequence; computed on demand (not serialized)
+   */
+  bool is_recurrence_cached_;
+  std::vector<BigInteger> recurrence_;
+  std::vector<BigInteger> recurrence_initial_terms_;
+  /**
+   * Column compressed copy of transition_count_matrix_ with fixed width values,
+   * valid only if all entries fit (not serialized)
+   */
+  bool is_native_matrix_cached_;
+  bool is_native_matrix_valid_;
+  std::vector<std::size_t> native_outer_index_;
+  std::vector<std::size_t> native_inner_index_;
+  std::vector<NativeCount> native_values_;
 private:
   static const int VLOG_LEVEL;
 };
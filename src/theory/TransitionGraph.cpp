@@ -0,0 +1,211 @@
+/*
+ * TransitionGraph.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "TransitionGraph.h"
+
+namespace Vlab {
+namespace Theory {
+
+const int TransitionGraph::VLOG_LEVEL = 20;
+
+TransitionGraph::TransitionGraph()
+    : offsets_ {0} {
+}
+
+TransitionGraph::~TransitionGraph() {
+}
+
+int TransitionGraph::AddNode() {
+  offsets_.push_back(offsets_.back());
+  return num_of_nodes() - 1;
+}
+
+void TransitionGraph::AddEdge(int to, const BigInteger& multiplicity) {
+  CHECK_GT(num_of_nodes(), 0) << "edge without a node";
+  targets_.push_back(to);
+  multiplicities_.push_back(multiplicity);
+  ++offsets_.back();
+}
+
+int TransitionGraph::num_of_nodes() const {
+  return offsets_.size() - 1;
+}
+
+int TransitionGraph::num_of_edges() const {
+  return targets_.size();
+}
+
+int TransitionGraph::get_offset(int node) const {
+  return offsets_[node];
+}
+
+int TransitionGraph::get_target(int edge) const {
+  return targets_[edge];
+}
+
+const TransitionGraph::BigInteger& TransitionGraph::get_multiplicity(int edge) const {
+  return multiplicities_[edge];
+}
+
+bool TransitionGraph::IsReachable(int from, int to) const {
+  std::vector<bool> is_visited(num_of_nodes(), false);
+  std::vector<int> work_list {from};
+  while (not work_list.empty()) {
+    int node = work_list.back();
+    work_list.pop_back();
+    for (int edge = offsets_[node]; edge < offsets_[node + 1]; ++edge) {
+      int next_node = targets_[edge];
+      if (next_node == to) {
+        return true;
+      } else if (not is_visited[next_node]) {
+        is_visited[next_node] = true;
+        work_list.push_back(next_node);
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * Depth first search that keeps the next edge of each node on the path
+ */
+bool TransitionGraph::HasCycle(int from) const {
+  enum class Color : char {
+    WHITE, GRAY, BLACK
+  };
+  std::vector<Color> colors(num_of_nodes(), Color::WHITE);
+  std::vector<std::pair<int, int>> path {std::make_pair(from, offsets_[from])};
+  colors[from] = Color::GRAY;
+  while (not path.empty()) {
+    auto& current = path.back();
+    if (current.second == offsets_[current.first + 1]) {
+      colors[current.first] = Color::BLACK;
+      path.pop_back();
+      continue;
+    }
+    int next_node = targets_[current.second++];
+    if (colors[next_node] == Color::GRAY) {
+      return true;
+    } else if (colors[next_node] == Color::WHITE) {
+      colors[next_node] = Color::GRAY;
+      path.push_back(std::make_pair(next_node, offsets_[next_node]));
+    }
+  }
+  return false;
+}
+
+/**
+ * Advances the set of nodes reachable with exactly k steps one step at a time
+ */
+std::vector<int> TransitionGraph::GetNodesReachableBy(int from, int min_walk, int max_walk) const {
+  std::vector<bool> is_collected(num_of_nodes(), false), is_in_frontier(num_of_nodes(), false);
+  std::vector<int> frontier {from}, next_frontier, nodes;
+  for (int walk = 0; walk <= max_walk and not frontier.empty(); ++walk) {
+    if (walk >= min_walk) {
+      for (int node : frontier) {
+        if (not is_collected[node]) {
+          is_collected[node] = true;
+          nodes.push_back(node);
+        }
+      }
+    }
+    if (walk == max_walk) {
+      break;
+    }
+    next_frontier.clear();
+    for (int node : frontier) {
+      for (int edge = offsets_[node]; edge < offsets_[node + 1]; ++edge) {
+        if (not is_in_frontier[targets_[edge]]) {
+          is_in_frontier[targets_[edge]] = true;
+          next_frontier.push_back(targets_[edge]);
+        }
+      }
+    }
+    for (int node : next_frontier) {
+      is_in_frontier[node] = false;
+    }
+    frontier.swap(next_frontier);
+  }
+  std::sort(nodes.begin(), nodes.end());
+  return nodes;
+}
+
+std::vector<int> TransitionGraph::FindSCCs(int from) const {
+  std::vector<int> scc_ids(num_of_nodes(), -1), disc(num_of_nodes(), -1), low(num_of_nodes(), -1);
+  std::vector<bool> is_stack_member(num_of_nodes(), false);
+  std::vector<int> st;
+  std::vector<std::pair<int, int>> path;
+  int time = 0, num_of_sccs = 0;
+
+  auto discover = [&](int node) {
+    disc[node] = low[node] = time++;
+    st.push_back(node);
+    is_stack_member[node] = true;
+    path.push_back(std::make_pair(node, offsets_[node]));
+  };
+
+  discover(from);
+  while (not path.empty()) {
+    auto& current = path.back();
+    const int node = current.first;
+    if (current.second < offsets_[node + 1]) {
+      int next_node = targets_[current.second++];
+      if (disc[next_node] == -1) {
+        discover(next_node);
+      } else if (is_stack_member[next_node]) {
+        low[node] = std::min(low[node], disc[next_node]);
+      }
+      continue;
+    }
+
+    path.pop_back();
+    if (not path.empty()) {
+      low[path.back().first] = std::min(low[path.back().first], low[node]);
+    }
+    if (low[node] == disc[node]) {
+      int member = -1;
+      do {
+        member = st.back();
+        st.pop_back();
+        is_stack_member[member] = false;
+        scc_ids[member] = num_of_sccs;
+      } while (member != node);
+      ++num_of_sccs;
+    }
+  }
+
+  DVLOG(VLOG_LEVEL) << num_of_sccs << " sccs reachable from " << from;
+  return scc_ids;
+}
+
+std::vector<bool> TransitionGraph::FindCyclicNodes(int from) const {
+  auto scc_ids = FindSCCs(from);
+  std::vector<int> scc_sizes(num_of_nodes(), 0);
+  for (int id : scc_ids) {
+    if (id != -1) {
+      ++scc_sizes[id];
+    }
+  }
+
+  std::vector<bool> is_cyclic(num_of_nodes(), false);
+  for (int node = 0; node < num_of_nodes(); ++node) {
+    if (scc_ids[node] == -1) {
+      continue;
+    }
+    is_cyclic[node] = (scc_sizes[scc_ids[node]] > 1);
+    for (int edge = offsets_[node]; edge < offsets_[node + 1] and not is_cyclic[node]; ++edge) {
+      is_cyclic[node] = (targets_[edge] == node);
+    }
+  }
+  return is_cyclic;
+}
+
+} /* namespace Theory */
+} /* namespace Vlab */
@@ -0,0 +1,81 @@
+/*
+ * TransitionGraph.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SRC_THEORY_TRANSITIONGRAPH_H_
+#define SRC_THEORY_TRANSITIONGRAPH_H_
+
+#include <algorithm>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include "../boost/multiprecision/cpp_int.hpp"
+
+namespace Vlab {
+namespace Theory {
+
+class TransitionGraph;
+using TransitionGraph_ptr = TransitionGraph*;
+
+/**
+ * Successor graph of an automaton in compressed sparse row form. Edges of node i are stored at
+ * [get_offset(i), get_offset(i + 1)) together with the number of symbols (multiplicity) on them.
+ * Analyses are iterative so that large automata do not exhaust the call stack.
+ */
+class TransitionGraph {
+ public:
+  using BigInteger = boost::multiprecision::cpp_int;
+
+  TransitionGraph();
+  virtual ~TransitionGraph();
+
+  /**
+   * Nodes are added in increasing id order, edges go to the last added node
+   */
+  int AddNode();
+  void AddEdge(int to, const BigInteger& multiplicity);
+
+  int num_of_nodes() const;
+  int num_of_edges() const;
+  int get_offset(int node) const;
+  int get_target(int edge) const;
+  const BigInteger& get_multiplicity(int edge) const;
+
+  /**
+   * @returns true if there is a non-empty path between the nodes
+   */
+  bool IsReachable(int from, int to) const;
+  bool HasCycle(int from) const;
+  std::vector<int> GetNodesReachableBy(int from, int min_walk, int max_walk) const;
+  /**
+   * Tarjan's algorithm over the nodes reachable from 'from'
+   * @returns scc id of each node, -1 for unreachable nodes; ids are in reverse topological order
+   */
+  std::vector<int> FindSCCs(int from) const;
+  /**
+   * @returns true for each reachable node that is on a cycle
+   */
+  std::vector<bool> FindCyclicNodes(int from) const;
+
+ protected:
+  std::vector<int> offsets_;
+  std::vector<int> targets_;
+  std::vector<BigInteger> multiplicities_;
+
+ private:
+  static const int VLOG_LEVEL;
+};
+
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* SRC_THEORY_TRANSITIONGRAPH_H_ */
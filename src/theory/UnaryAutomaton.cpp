@@ -237,8 +237,6 @@ IntAutomaton_ptr UnaryAutomaton::toIntAutomaton(int number_of_variables, bool ad
   int_dfa = dfaMinimize(temp_dfa);
   dfaFree(temp_dfa);
 
-  int_auto = new IntAutomaton(int_dfa, number_of_variables);
-
   if(!has_sink) {
     for(int i = 0; i < int_dfa->ns; i++) {
       if(int_dfa->f[i] == 0) {
@@ -247,6 +245,8 @@ IntAutomaton_ptr UnaryAutomaton::toIntAutomaton(int number_of_variables, bool ad
     }
   }
 
+  int_auto = new IntAutomaton(int_dfa, number_of_variables);
+
   int_auto->setMinus1(add_minus_one);
   delete[] indices; indices = nullptr;
   delete[] statuses; statuses = nullptr;
@@ -13,8 +13,10 @@
 namespace Vlab {
 namespace Option {
 
-std::string Theory::TMP_PATH     = ".";
-std::string Theory::SCRIPT_PATH  = ".";
+thread_local std::string Theory::TMP_PATH     = ".";
+thread_local std::string Theory::SCRIPT_PATH  = ".";
+thread_local bool Theory::USE_INTERVAL_DFA    = false;
+thread_local int Theory::NUM_THREADS          = 1;
 
 } /* namespace Option */
 } /* namespace Vlab */
@@ -16,10 +16,15 @@
 namespace Vlab {
 namespace Option {
 
+/**
+ * Options are kept per thread, a driver installs its own values (see Option::Context)
+ */
 class Theory {
 public:
-  static std::string TMP_PATH;
-  static std::string SCRIPT_PATH;
+  static thread_local std::string TMP_PATH;
+  static thread_local std::string SCRIPT_PATH;
+  static thread_local bool USE_INTERVAL_DFA;
+  static thread_local int NUM_THREADS;
 };
 
 } /* namespace Option */
@@ -0,0 +1,101 @@
+/*
+ * MemoryBuffer.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "MemoryBuffer.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Vlab {
+namespace Util {
+
+MemoryStreamBuffer::MemoryStreamBuffer(const char* data, std::size_t size) {
+  char* begin = const_cast<char*>(data);  // get area is never written
+  setg(begin, begin, begin + size);
+}
+
+MemoryStreamBuffer::~MemoryStreamBuffer() {
+}
+
+MemoryStreamBuffer::pos_type MemoryStreamBuffer::seekoff(off_type offset, std::ios_base::seekdir direction,
+                                                          std::ios_base::openmode mode) {
+  char* position = gptr();
+  if (direction == std::ios_base::beg) {
+    position = eback() + offset;
+  } else if (direction == std::ios_base::cur) {
+    position = gptr() + offset;
+  } else if (direction == std::ios_base::end) {
+    position = egptr() + offset;
+  }
+  if (not (mode & std::ios_base::in) or position < eback() or position > egptr()) {
+    return pos_type(off_type(-1));
+  }
+  setg(eback(), position, egptr());
+  return pos_type(position - eback());
+}
+
+MemoryStreamBuffer::pos_type MemoryStreamBuffer::seekpos(pos_type position, std::ios_base::openmode mode) {
+  return seekoff(off_type(position), std::ios_base::beg, mode);
+}
+
+MappedFile::MappedFile(const std::string& file_name)
+    : file_descriptor_(-1),
+      data_(nullptr),
+      size_(0) {
+  file_descriptor_ = open(file_name.c_str(), O_RDONLY);
+  if (file_descriptor_ == -1) {
+    return;
+  }
+  struct stat file_status;
+  if (fstat(file_descriptor_, &file_status) == -1) {
+    close(file_descriptor_);
+    file_descriptor_ = -1;
+    return;
+  }
+  size_ = file_status.st_size;
+  if (size_ == 0) {  // an empty file cannot be mapped
+    return;
+  }
+  void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file_descriptor_, 0);
+  if (data == MAP_FAILED) {
+    close(file_descriptor_);
+    file_descriptor_ = -1;
+    size_ = 0;
+    return;
+  }
+  madvise(data, size_, MADV_SEQUENTIAL);
+  data_ = static_cast<char*>(data);
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+  if (file_descriptor_ != -1) {
+    close(file_descriptor_);
+  }
+}
+
+bool MappedFile::is_open() const {
+  return file_descriptor_ != -1;
+}
+
+const char* MappedFile::data() const {
+  return data_;
+}
+
+std::size_t MappedFile::size() const {
+  return size_;
+}
+
+} /* namespace Util */
+} /* namespace Vlab */
@@ -0,0 +1,60 @@
+/*
+ * MemoryBuffer.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SRC_UTILS_MEMORYBUFFER_H_
+#define SRC_UTILS_MEMORYBUFFER_H_
+
+#include <cstddef>
+#include <streambuf>
+#include <string>
+
+namespace Vlab {
+namespace Util {
+
+/**
+ * Read only stream buffer over memory owned by the caller, streams read it without copying
+ */
+class MemoryStreamBuffer : public std::streambuf {
+ public:
+  MemoryStreamBuffer(const char* data, std::size_t size);
+  MemoryStreamBuffer(const MemoryStreamBuffer&) = delete;
+  MemoryStreamBuffer& operator=(const MemoryStreamBuffer&) = delete;
+  virtual ~MemoryStreamBuffer();
+
+ protected:
+  pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode mode) override;
+  pos_type seekpos(pos_type position, std::ios_base::openmode mode) override;
+};
+
+/**
+ * Maps a file into memory for reading, pages are loaded on demand and can be dropped by the
+ * kernel at any time, so a large input does not need the same amount of heap
+ */
+class MappedFile {
+ public:
+  MappedFile(const std::string& file_name);
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+  bool is_open() const;
+  const char* data() const;
+  std::size_t size() const;
+
+ protected:
+  int file_descriptor_;
+  char* data_;
+  std::size_t size_;
+};
+
+} /* namespace Util */
+} /* namespace Vlab */
+
+#endif /* SRC_UTILS_MEMORYBUFFER_H_ */
@@ -48,7 +48,7 @@ const int RegularExpression::AUTOMATON = 0x0010;
 const int RegularExpression::INTERVAL = 0x0020;
 const int RegularExpression::ALL = 0xffff;
 const int RegularExpression::NONE = 0x0000;
-int RegularExpression::DEFAULT = 0x000f;
+thread_local int RegularExpression::DEFAULT = 0x000f;
 
 RegularExpression::RegularExpression()
     : type_(Type::NONE),
@@ -160,6 +160,35 @@ std::string RegularExpression::constant_str() const {
   return ss.str();
 }
 
+/**
+ * @returns true if the expression is a union of constant strings
+ */
+bool RegularExpression::is_constant_string_union() const {
+  if (type_ == Type::UNION) {
+    return exp1_->is_constant_string_union() and exp2_->is_constant_string_union();
+  }
+  return type_ == Type::STRING or type_ == Type::CHAR;
+}
+
+/**
+ * @returns strings of a constant string union
+ */
+std::vector<std::string> RegularExpression::constant_strings() const {
+  std::vector<std::string> strings;
+  std::vector<const RegularExpression*> regex_stack {this};
+  while (not regex_stack.empty()) {
+    auto regex = regex_stack.back();
+    regex_stack.pop_back();
+    if (regex->type_ == Type::UNION) {
+      regex_stack.push_back(regex->exp2_);
+      regex_stack.push_back(regex->exp1_);
+    } else if (regex->type_ == Type::STRING or regex->type_ == Type::CHAR) {
+      strings.push_back(regex->constant_str());
+    }
+  }
+  return strings;
+}
+
 std::string RegularExpression::str() const {
   std::stringstream ss;
   switch (type_) {
@@ -607,7 +636,7 @@ RegularExpression_ptr RegularExpression::parseUnionExp() {
 
 RegularExpression_ptr RegularExpression::parseInterExp() {
   RegularExpression_ptr regex = parseConcatExp();
-  if (check(INTERSECTION) and match('|')) {
+  if (check(INTERSECTION) and match('&')) {
     regex = makeIntersection(regex, parseInterExp());
   }
   return regex;
@@ -615,7 +644,7 @@ RegularExpression_ptr RegularExpression::parseInterExp() {
 
 RegularExpression_ptr RegularExpression::parseConcatExp() {
   RegularExpression_ptr regex = parseRepeatExp();
-  if (more() and !peek(")|")) {
+  if (more() and !peek(")|") and (!check(INTERSECTION) or !peek("&"))) {
     regex = makeConcatenation(regex, parseConcatExp());
   }
   return regex;
@@ -41,6 +41,7 @@
 #include <cstdlib>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <glog/logging.h>
 
@@ -95,8 +96,9 @@ public:
   /**
    * Syntax flag, used as a default combinations of the flag
    * Enables all except AUTOMATON and INTERVAL
+   * (per thread, installed by the driver that uses it)
    */
-  static int DEFAULT;
+  static thread_local int DEFAULT;
 
   enum class Type : int {
     NONE = 0,
@@ -127,6 +129,8 @@ public:
 
   bool is_constant_string() const;
   std::string constant_str() const;
+  bool is_constant_string_union() const;
+  std::vector<std::string> constant_strings() const;
   std::string str() const;
   RegularExpression_ptr clone() const;
   static std::string escape_raw_string(std::string input);
@@ -110,15 +110,13 @@ JNIEXPORT void JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_setOption__ILjava_lang_
  * Method:    isSatisfiable
  * Signature: (Ljava/lang/String;)Z
  */
-JNIEXPORT jboolean JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_isSatisfiable
+JNIEXPORT jboolean JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_isSatisfiable__Ljava_lang_String_2
   (JNIEnv *env, jobject obj, jstring constraint) {
 
   Vlab::Driver *abc_driver = getHandle<Vlab::Driver>(env, obj);
-  std::istringstream input_constraint;
   const char* constraint_str = env->GetStringUTFChars(constraint, JNI_FALSE);
-  input_constraint.str(constraint_str);
   abc_driver->reset();
-  abc_driver->Parse(&input_constraint);
+  abc_driver->Parse(constraint_str, env->GetStringUTFLength(constraint));
   env->ReleaseStringUTFChars(constraint, constraint_str);
   abc_driver->InitializeSolver();
   abc_driver->Solve();
@@ -126,6 +124,35 @@ JNIEXPORT jboolean JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_isSatisfiable
   return (jboolean)result;
 }
 
+/*
+ * Class:     vlab_cs_ucsb_edu_DriverProxy
+ * Method:    isSatisfiable
+ * Signature: (Ljava/nio/ByteBuffer;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_isSatisfiable__Ljava_nio_ByteBuffer_2
+  (JNIEnv *env, jobject obj, jobject constraint) {
+
+  Vlab::Driver *abc_driver = getHandle<Vlab::Driver>(env, obj);
+  const char* constraint_buffer = static_cast<const char*>(env->GetDirectBufferAddress(constraint));
+  if (constraint_buffer == nullptr) {
+    jclass exception_class = env->FindClass("java/lang/IllegalArgumentException");
+    env->ThrowNew(exception_class, "constraint must be in a direct byte buffer");
+    return (jboolean)false;
+  }
+  // only the remaining bytes, [position, limit), belong to the constraint
+  jclass buffer_class = env->FindClass("java/nio/Buffer");
+  jmethodID buffer_position = env->GetMethodID(buffer_class, "position", "()I");
+  jmethodID buffer_limit = env->GetMethodID(buffer_class, "limit", "()I");
+  jint constraint_position = env->CallIntMethod(constraint, buffer_position);
+  jint constraint_limit = env->CallIntMethod(constraint, buffer_limit);
+  abc_driver->reset();
+  abc_driver->Parse(constraint_buffer + constraint_position, constraint_limit - constraint_position);
+  abc_driver->InitializeSolver();
+  abc_driver->Solve();
+  bool result = abc_driver->is_sat();
+  return (jboolean)result;
+}
+
 /*
  * Class:     vlab_cs_ucsb_edu_DriverProxy
  * Method:    countVariable
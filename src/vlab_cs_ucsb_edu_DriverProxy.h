@@ -44,9 +44,17 @@ JNIEXPORT void JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_setOption__ILjava_lang_
  * Method:    isSatisfiable
  * Signature: (Ljava/lang/String;)Z
  */
-JNIEXPORT jboolean JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_isSatisfiable
+JNIEXPORT jboolean JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_isSatisfiable__Ljava_lang_String_2
   (JNIEnv *, jobject, jstring);
 
+/*
+ * Class:     vlab_cs_ucsb_edu_DriverProxy
+ * Method:    isSatisfiable
+ * Signature: (Ljava/nio/ByteBuffer;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_isSatisfiable__Ljava_nio_ByteBuffer_2
+  (JNIEnv *, jobject, jobject);
+
 /*
  * Class:     vlab_cs_ucsb_edu_DriverProxy
  * Method:    countVariable
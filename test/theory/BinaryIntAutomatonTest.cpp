@@ -18,13 +18,39 @@ class PublicBinaryIntAutomaton : public BinaryIntAutomaton {
  public:
   using BinaryIntAutomaton::BinaryIntAutomaton;
   using BinaryIntAutomaton::type_;
-  using BinaryIntAutomaton::is_count_matrix_cached_;
   using BinaryIntAutomaton::dfa_;
   using BinaryIntAutomaton::num_of_variables_;
-  using BinaryIntAutomaton::count_matrix_;
   using BinaryIntAutomaton::is_natural_number_;
   using BinaryIntAutomaton::formula_;
+  using BinaryIntAutomaton::TransitionEnumerator;
 
+  /**
+   * Runs the dfa on the values of the formula variables, least significant bit first.
+   * Integers are read in two's complement, the last column is the sign column.
+   */
+  bool Accepts(const std::map<std::string, int>& values, const int bit_length = 8) {
+    std::vector<char> bits(num_of_variables_);
+    int state = dfa_->s;
+    for (int k = 0; k < bit_length; ++k) {
+      for (auto& entry : values) {
+        bits[formula_->get_variable_index(entry.first)] = ((static_cast<unsigned>(entry.second) >> k) & 1) ? '1' : '0';
+      }
+      state = NextState(state, bits);
+    }
+    return dfa_->f[state] == 1;
+  }
+
+ private:
+  int NextState(const int state, const std::vector<char>& bits) {
+    unsigned l, r, index;
+    unsigned p = dfa_->q[state];
+    LOAD_lri(&dfa_->bddm->node_table[p], l, r, index);
+    while (index != BDD_LEAF_INDEX) {
+      p = (bits[index] == '1') ? r : l;
+      LOAD_lri(&dfa_->bddm->node_table[p], l, r, index);
+    }
+    return l;
+  }
 };
 
 using namespace ::testing;
@@ -102,6 +128,231 @@ TEST_F(BinaryIntAutomatonTest, MakePhi) {
   // TODO add an automaton check wrt a expectation
 }
 
+TEST_F(BinaryIntAutomatonTest, TransitionEnumerator) {
+  PublicBinaryIntAutomaton::TransitionEnumerator transition_enumerator({3, 0, -2, 5});
+  EXPECT_EQ(8, transition_enumerator.num_of_transitions());
+
+  std::set<std::vector<char>> transitions;
+  std::vector<char> previous;
+  do {
+    auto& exception = transition_enumerator.exception();
+    ASSERT_EQ(5, exception.size());
+    EXPECT_EQ('X', exception[1]);
+    EXPECT_EQ('\0', exception[4]);
+    int sum = 0;
+    for (std::size_t i = 0; i < 4; ++i) {
+      if (exception[i] == '1') {
+        sum += std::vector<int> {3, 0, -2, 5}[i];
+      }
+    }
+    EXPECT_EQ(sum, transition_enumerator.sum());
+    if (not previous.empty()) {
+      int num_of_changes = 0;
+      for (std::size_t i = 0; i < exception.size(); ++i) {
+        num_of_changes += (previous[i] != exception[i]) ? 1 : 0;
+      }
+      EXPECT_EQ(1, num_of_changes);
+    }
+    previous = exception;
+    transitions.insert(exception);
+  } while (transition_enumerator.Next());
+  EXPECT_EQ(8, transitions.size());
+
+  transition_enumerator.Reset();
+  EXPECT_EQ(0, transition_enumerator.sum());
+  EXPECT_THAT(transition_enumerator.exception(), ElementsAre('0', 'X', '0', '0', '\0'));
+}
+
+TEST_F(BinaryIntAutomatonTest, MakeIntEquality) {
+  // x - 2y + 0z - 3 = 0
+  auto formula = new ArithmeticFormula();
+  formula->set_type(ArithmeticFormula::Type::EQ);
+  formula->set_constant(-3);
+  formula->add_variable("x", 1);
+  formula->add_variable("y", -2);
+  formula->add_variable("z", 0);
+
+  auto result = static_cast<PublicBinaryIntAutomaton*>(BinaryIntAutomaton::MakeAutomaton(formula, false));
+  EXPECT_TRUE(result->Accepts({{"x", 3}, {"y", 0}, {"z", 5}}));
+  EXPECT_TRUE(result->Accepts({{"x", 1}, {"y", -1}, {"z", -7}}));
+  EXPECT_TRUE(result->Accepts({{"x", -5}, {"y", -4}, {"z", 0}}));
+  EXPECT_FALSE(result->Accepts({{"x", 2}, {"y", 0}, {"z", 0}}));
+  EXPECT_FALSE(result->Accepts({{"x", 3}, {"y", 1}, {"z", 0}}));
+  EXPECT_FALSE(result->Accepts({{"x", -3}, {"y", 0}, {"z", 0}}));
+  delete result;
+
+  // x + y + 0z + 4 != 0
+  formula = new ArithmeticFormula();
+  formula->set_type(ArithmeticFormula::Type::NOTEQ);
+  formula->set_constant(4);
+  formula->add_variable("x", 1);
+  formula->add_variable("y", 1);
+  formula->add_variable("z", 0);
+
+  result = static_cast<PublicBinaryIntAutomaton*>(BinaryIntAutomaton::MakeAutomaton(formula, false));
+  EXPECT_FALSE(result->Accepts({{"x", -1}, {"y", -3}, {"z", 9}}));
+  EXPECT_FALSE(result->Accepts({{"x", 2}, {"y", -6}, {"z", 0}}));
+  EXPECT_TRUE(result->Accepts({{"x", 0}, {"y", 0}, {"z", -4}}));
+  EXPECT_TRUE(result->Accepts({{"x", 4}, {"y", 0}, {"z", 0}}));
+  delete result;
+}
+
+TEST_F(BinaryIntAutomatonTest, MakeNaturalNumberEquality) {
+  // 2x + 0y + 3z - 12 = 0
+  auto formula = new ArithmeticFormula();
+  formula->set_type(ArithmeticFormula::Type::EQ);
+  formula->set_constant(-12);
+  formula->add_variable("x", 2);
+  formula->add_variable("y", 0);
+  formula->add_variable("z", 3);
+
+  auto result = static_cast<PublicBinaryIntAutomaton*>(BinaryIntAutomaton::MakeAutomaton(formula, true));
+  EXPECT_TRUE(result->Accepts({{"x", 6}, {"y", 0}, {"z", 0}}));
+  EXPECT_TRUE(result->Accepts({{"x", 3}, {"y", 7}, {"z", 2}}));
+  EXPECT_TRUE(result->Accepts({{"x", 0}, {"y", 100}, {"z", 4}}));
+  EXPECT_FALSE(result->Accepts({{"x", 1}, {"y", 0}, {"z", 3}}));
+  EXPECT_FALSE(result->Accepts({{"x", 0}, {"y", 12}, {"z", 0}}));
+  delete result;
+
+  // x - y = 0, a zero constant
+  formula = new ArithmeticFormula();
+  formula->set_type(ArithmeticFormula::Type::EQ);
+  formula->set_constant(0);
+  formula->add_variable("x", 1);
+  formula->add_variable("y", -1);
+
+  result = static_cast<PublicBinaryIntAutomaton*>(BinaryIntAutomaton::MakeAutomaton(formula, true));
+  EXPECT_TRUE(result->Accepts({{"x", 0}, {"y", 0}}));
+  EXPECT_TRUE(result->Accepts({{"x", 37}, {"y", 37}}));
+  EXPECT_FALSE(result->Accepts({{"x", 37}, {"y", 36}}));
+  delete result;
+}
+
+TEST_F(BinaryIntAutomatonTest, MakeIntLessThan) {
+  // x - 3y + 0z + 2 < 0
+  auto formula = new ArithmeticFormula();
+  formula->set_type(ArithmeticFormula::Type::LT);
+  formula->set_constant(2);
+  formula->add_variable("x", 1);
+  formula->add_variable("y", -3);
+  formula->add_variable("z", 0);
+
+  auto result = static_cast<PublicBinaryIntAutomaton*>(BinaryIntAutomaton::MakeAutomaton(formula, false));
+  EXPECT_TRUE(result->Accepts({{"x", 0}, {"y", 1}, {"z", 0}}));
+  EXPECT_TRUE(result->Accepts({{"x", -10}, {"y", -2}, {"z", 50}}));
+  EXPECT_TRUE(result->Accepts({{"x", -3}, {"y", 0}, {"z", -50}}));
+  EXPECT_FALSE(result->Accepts({{"x", 1}, {"y", 1}, {"z", 0}}));
+  EXPECT_FALSE(result->Accepts({{"x", -2}, {"y", 0}, {"z", 0}}));
+  EXPECT_FALSE(result->Accepts({{"x", 0}, {"y", -1}, {"z", 0}}));
+  delete result;
+
+  // x + y - 5 >= 0
+  formula = new ArithmeticFormula();
+  formula->set_type(ArithmeticFormula::Type::GE);
+  formula->set_constant(-5);
+  formula->add_variable("x", 1);
+  formula->add_variable("y", 1);
+
+  result = static_cast<PublicBinaryIntAutomaton*>(BinaryIntAutomaton::MakeAutomaton(formula, false));
+  EXPECT_TRUE(result->Accepts({{"x", 5}, {"y", 0}}));
+  EXPECT_TRUE(result->Accepts({{"x", 10}, {"y", -4}}));
+  EXPECT_FALSE(result->Accepts({{"x", 2}, {"y", 2}}));
+  EXPECT_FALSE(result->Accepts({{"x", -5}, {"y", -5}}));
+  delete result;
+}
+
+TEST_F(BinaryIntAutomatonTest, MakeNaturalNumberLessThan) {
+  // 2x + 0y + z - 7 < 0
+  auto formula = new ArithmeticFormula();
+  formula->set_type(ArithmeticFormula::Type::LT);
+  formula->set_constant(-7);
+  formula->add_variable("x", 2);
+  formula->add_variable("y", 0);
+  formula->add_variable("z", 1);
+
+  auto result = static_cast<PublicBinaryIntAutomaton*>(BinaryIntAutomaton::MakeAutomaton(formula, true));
+  EXPECT_TRUE(result->Accepts({{"x", 0}, {"y", 0}, {"z", 0}}));
+  EXPECT_TRUE(result->Accepts({{"x", 3}, {"y", 90}, {"z", 0}}));
+  EXPECT_TRUE(result->Accepts({{"x", 1}, {"y", 0}, {"z", 4}}));
+  EXPECT_FALSE(result->Accepts({{"x", 3}, {"y", 0}, {"z", 1}}));
+  EXPECT_FALSE(result->Accepts({{"x", 0}, {"y", 0}, {"z", 7}}));
+  EXPECT_FALSE(result->Accepts({{"x", 4}, {"y", 1}, {"z", 0}}));
+  delete result;
+
+  // x - y <= -2
+  formula = new ArithmeticFormula();
+  formula->set_type(ArithmeticFormula::Type::LE);
+  formula->set_constant(2);
+  formula->add_variable("x", 1);
+  formula->add_variable("y", -1);
+
+  result = static_cast<PublicBinaryIntAutomaton*>(BinaryIntAutomaton::MakeAutomaton(formula, true));
+  EXPECT_TRUE(result->Accepts({{"x", 0}, {"y", 2}}));
+  EXPECT_TRUE(result->Accepts({{"x", 10}, {"y", 40}}));
+  EXPECT_FALSE(result->Accepts({{"x", 1}, {"y", 2}}));
+  EXPECT_FALSE(result->Accepts({{"x", 5}, {"y", 0}}));
+  delete result;
+}
+
+TEST_F(BinaryIntAutomatonTest, ToIntAutomaton) {
+  auto make_formula = []() {
+    auto formula = new ArithmeticFormula();
+    formula->set_type(ArithmeticFormula::Type::VAR);
+    formula->add_variable("x", 1);
+    return formula;
+  };
+
+  // constants only, {2, 5}
+  SemilinearSet constants_set;
+  constants_set.addConstant(2);
+  constants_set.addConstant(5);
+  auto binary_auto = BinaryIntAutomaton::MakeAutomaton(&constants_set, "x", make_formula(), false);
+  auto expected_auto = IntAutomaton::makeAutomaton(&constants_set);
+  auto int_auto = binary_auto->ToIntAutomaton(IntAutomaton::DEFAULT_NUM_OF_VARIABLES);
+  EXPECT_TRUE(int_auto->IsEqual(expected_auto));
+  delete int_auto;
+
+  int_auto = binary_auto->ToIntAutomaton(IntAutomaton::DEFAULT_NUM_OF_VARIABLES, false, &constants_set);
+  EXPECT_TRUE(int_auto->IsEqual(expected_auto));
+  delete int_auto;
+
+  // a candidate that does not match is not used
+  SemilinearSet candidate_set;
+  candidate_set.addConstant(2);
+  int_auto = binary_auto->ToIntAutomaton(IntAutomaton::DEFAULT_NUM_OF_VARIABLES, false, &candidate_set);
+  EXPECT_TRUE(int_auto->IsEqual(expected_auto));
+  delete int_auto;
+  delete expected_auto;
+  delete binary_auto;
+
+  // with a cycle, {1} U {4 + 3k}
+  SemilinearSet cycle_set;
+  cycle_set.addConstant(1);
+  cycle_set.setCycleHead(4);
+  cycle_set.setPeriod(3);
+  cycle_set.addPeriodicConstant(0);
+  binary_auto = BinaryIntAutomaton::MakeAutomaton(&cycle_set, "x", make_formula(), false);
+  expected_auto = IntAutomaton::makeAutomaton(&cycle_set);
+  int_auto = binary_auto->ToIntAutomaton(IntAutomaton::DEFAULT_NUM_OF_VARIABLES, false, &cycle_set);
+  EXPECT_TRUE(int_auto->IsEqual(expected_auto));
+  EXPECT_FALSE(int_auto->isEmptyLanguage());
+  delete int_auto;
+  delete expected_auto;
+  delete binary_auto;
+
+  // empty set
+  SemilinearSet empty_set;
+  binary_auto = BinaryIntAutomaton::MakeAutomaton(&empty_set, "x", make_formula(), false);
+  int_auto = binary_auto->ToIntAutomaton(IntAutomaton::DEFAULT_NUM_OF_VARIABLES);
+  EXPECT_TRUE(int_auto->isEmptyLanguage());
+  delete int_auto;
+
+  int_auto = binary_auto->ToIntAutomaton(IntAutomaton::DEFAULT_NUM_OF_VARIABLES, false, &empty_set);
+  EXPECT_TRUE(int_auto->isEmptyLanguage());
+  delete int_auto;
+  delete binary_auto;
+}
+
 //TEST_F(BinaryIntAutomatonTest, Complement) {
 //  std::stringstream ss;
 //    std::string expected;
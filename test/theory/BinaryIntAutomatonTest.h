@@ -17,6 +17,8 @@
 #include "helper/FileHelper.h"
 //#include "theory/mock/MockBinaryIntAutomaton.h"
 #include "theory/BinaryIntAutomaton.h"
+#include "theory/IntAutomaton.h"
+#include "theory/SemilinearSet.h"
 
 namespace Vlab {
 namespace Theory {
@@ -0,0 +1,93 @@
+/*
+ * IntAutomatonTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "IntAutomatonTest.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+using namespace ::testing;
+
+void IntAutomatonTest::SetUp() {
+}
+
+void IntAutomatonTest::TearDown() {
+}
+
+SemilinearSet_ptr IntAutomatonTest::MakeSemilinearSet(const std::vector<int>& constants, int cycle_head, int period,
+                                                      const std::vector<int>& periodic_constants) {
+  SemilinearSet_ptr semilinear_set = new SemilinearSet();
+  for (int c : constants) {
+    semilinear_set->addConstant(c);
+  }
+  semilinear_set->setCycleHead(cycle_head);
+  semilinear_set->setPeriod(period);
+  for (int r : periodic_constants) {
+    semilinear_set->addPeriodicConstant(r);
+  }
+  return semilinear_set;
+}
+
+TEST_F(IntAutomatonTest, SemilinearSetOfConstants) {
+  auto semilinear_set = MakeSemilinearSet({0, 3, 5});
+  auto int_auto = IntAutomaton::makeAutomaton(semilinear_set);
+
+  auto result = int_auto->getSemilinearSet();
+  EXPECT_EQ(0, result->getCycleHead());
+  EXPECT_EQ(0, result->getPeriod());
+  EXPECT_THAT(result->getConstants(), ElementsAre(0, 3, 5));
+  EXPECT_THAT(result->getPeriodicConstants(), IsEmpty());
+
+  auto round_trip_auto = IntAutomaton::makeAutomaton(result);
+  EXPECT_TRUE(round_trip_auto->IsEqual(int_auto));
+
+  delete round_trip_auto;
+  delete result;
+  delete int_auto;
+  delete semilinear_set;
+}
+
+TEST_F(IntAutomatonTest, SemilinearSetWithCycle) {
+  // {0, 3} U {5 + 3k}
+  auto semilinear_set = MakeSemilinearSet({0, 3}, 4, 3, {1});
+  auto int_auto = IntAutomaton::makeAutomaton(semilinear_set);
+
+  auto result = int_auto->getSemilinearSet();
+  EXPECT_EQ(4, result->getCycleHead());
+  EXPECT_EQ(3, result->getPeriod());
+  EXPECT_THAT(result->getConstants(), ElementsAre(0, 3));
+  EXPECT_THAT(result->getPeriodicConstants(), ElementsAre(1));
+
+  auto round_trip_auto = IntAutomaton::makeAutomaton(result);
+  EXPECT_TRUE(round_trip_auto->IsEqual(int_auto));
+
+  delete round_trip_auto;
+  delete result;
+  delete int_auto;
+  delete semilinear_set;
+}
+
+TEST_F(IntAutomatonTest, EmptySemilinearSet) {
+  auto semilinear_set = MakeSemilinearSet({});
+  auto int_auto = IntAutomaton::makeAutomaton(semilinear_set);
+  EXPECT_TRUE(int_auto->isEmptyLanguage());
+
+  auto result = int_auto->getSemilinearSet();
+  EXPECT_TRUE(result->isEmptySet());
+
+  delete result;
+  delete int_auto;
+  delete semilinear_set;
+}
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
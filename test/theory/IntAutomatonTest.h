@@ -0,0 +1,41 @@
+/*
+ * IntAutomatonTest.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_INTAUTOMATONTEST_H_
+#define THEORY_INTAUTOMATONTEST_H_
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "theory/IntAutomaton.h"
+#include "theory/SemilinearSet.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+class IntAutomatonTest : public ::testing::Test {
+protected:
+  virtual void SetUp();
+  virtual void TearDown();
+
+  /**
+   * Semilinear set with the given constants and, if period is not 0, the given periodic constants
+   */
+  SemilinearSet_ptr MakeSemilinearSet(const std::vector<int>& constants, int cycle_head = 0, int period = 0,
+                                      const std::vector<int>& periodic_constants = {});
+};
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_INTAUTOMATONTEST_H_ */
@@ -0,0 +1,115 @@
+/*
+ * IntervalDfaTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "IntervalDfaTest.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+using namespace ::testing;
+
+void IntervalDfaTest::SetUp() {
+}
+
+void IntervalDfaTest::TearDown() {
+}
+
+bool IntervalDfaTest::Accepts(const IntervalDfa& interval_dfa, const std::string& input) {
+  int state = interval_dfa.get_initial_state();
+  for (char c : input) {
+    state = interval_dfa.NextState(state, static_cast<unsigned char>(c));
+  }
+  return interval_dfa.is_accepting(state);
+}
+
+IntervalDfa IntervalDfaTest::MakeCharRangePlus(int from, int to) {
+  IntervalDfa interval_dfa;
+  int initial_state = interval_dfa.AddState(false);
+  int accepting_state = interval_dfa.AddState(true);
+  interval_dfa.AddTransition(initial_state, from, to, accepting_state);
+  interval_dfa.AddTransition(accepting_state, from, to, accepting_state);
+  interval_dfa.set_initial_state(initial_state);
+  return interval_dfa;
+}
+
+IntervalDfa IntervalDfaTest::MakeString(const std::string& str) {
+  IntervalDfa interval_dfa;
+  int state = interval_dfa.AddState(str.empty());
+  interval_dfa.set_initial_state(state);
+  for (std::size_t i = 0; i < str.size(); ++i) {
+    int next_state = interval_dfa.AddState(i + 1 == str.size());
+    int c = static_cast<unsigned char>(str[i]);
+    interval_dfa.AddTransition(state, c, c, next_state);
+    state = next_state;
+  }
+  return interval_dfa;
+}
+
+TEST_F(IntervalDfaTest, NextState) {
+  IntervalDfa interval_dfa;
+  int state = interval_dfa.AddState(false);
+  interval_dfa.AddTransition(state, 'a', 'f', state);
+  interval_dfa.AddTransition(state, 'g', 'k', state);
+  interval_dfa.AddTransition(state, 'x', 255, state);
+  interval_dfa.set_initial_state(state);
+
+  EXPECT_EQ(2, interval_dfa.get_intervals(state).size());
+  EXPECT_EQ(state, interval_dfa.NextState(state, 'a'));
+  EXPECT_EQ(state, interval_dfa.NextState(state, 'k'));
+  EXPECT_EQ(state, interval_dfa.NextState(state, 255));
+  EXPECT_EQ(IntervalDfa::REJECT, interval_dfa.NextState(state, 'l'));
+  EXPECT_EQ(IntervalDfa::REJECT, interval_dfa.NextState(state, 0));
+  EXPECT_EQ(IntervalDfa::REJECT, interval_dfa.NextState(IntervalDfa::REJECT, 'a'));
+}
+
+TEST_F(IntervalDfaTest, Intersect) {
+  auto intersect_dfa = MakeCharRangePlus('a', 'm').Intersect(MakeCharRangePlus('h', 'z'));
+  EXPECT_TRUE(Accepts(intersect_dfa, "hijklm"));
+  EXPECT_FALSE(Accepts(intersect_dfa, "ghi"));
+  EXPECT_FALSE(Accepts(intersect_dfa, "mn"));
+  EXPECT_FALSE(Accepts(intersect_dfa, ""));
+  EXPECT_FALSE(intersect_dfa.IsEmpty());
+
+  auto empty_dfa = MakeCharRangePlus('a', 'f').Intersect(MakeCharRangePlus('g', 'z'));
+  EXPECT_TRUE(empty_dfa.IsEmpty());
+}
+
+TEST_F(IntervalDfaTest, Union) {
+  auto union_dfa = MakeString("abc").Union(MakeCharRangePlus('0', '9'));
+  EXPECT_TRUE(Accepts(union_dfa, "abc"));
+  EXPECT_TRUE(Accepts(union_dfa, "2016"));
+  EXPECT_FALSE(Accepts(union_dfa, "ab"));
+  EXPECT_FALSE(Accepts(union_dfa, "abc1"));
+  EXPECT_FALSE(Accepts(union_dfa, ""));
+
+  auto with_empty_dfa = IntervalDfa().Union(MakeString(""));
+  EXPECT_TRUE(Accepts(with_empty_dfa, ""));
+  EXPECT_FALSE(Accepts(with_empty_dfa, "a"));
+}
+
+TEST_F(IntervalDfaTest, Concat) {
+  auto concat_dfa = MakeCharRangePlus('a', 'z').Concat(MakeString("ab"));
+  EXPECT_TRUE(Accepts(concat_dfa, "aab"));
+  EXPECT_TRUE(Accepts(concat_dfa, "abab"));
+  EXPECT_TRUE(Accepts(concat_dfa, "zzzab"));
+  EXPECT_FALSE(Accepts(concat_dfa, "ab"));
+  EXPECT_FALSE(Accepts(concat_dfa, "aaba"));
+
+  auto empty_string_dfa = MakeString("").Concat(MakeString("x"));
+  EXPECT_TRUE(Accepts(empty_string_dfa, "x"));
+  EXPECT_FALSE(Accepts(empty_string_dfa, ""));
+
+  EXPECT_TRUE(MakeString("x").Concat(IntervalDfa()).IsEmpty());
+}
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
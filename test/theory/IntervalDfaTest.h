@@ -0,0 +1,47 @@
+/*
+ * IntervalDfaTest.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_INTERVALDFATEST_H_
+#define THEORY_INTERVALDFATEST_H_
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "theory/IntervalDfa.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+class IntervalDfaTest : public ::testing::Test {
+protected:
+  virtual void SetUp();
+  virtual void TearDown();
+
+  /**
+   * Runs the dfa on the input
+   */
+  bool Accepts(const IntervalDfa& interval_dfa, const std::string& input);
+  /**
+   * Dfa for [from-to]+
+   */
+  IntervalDfa MakeCharRangePlus(int from, int to);
+  /**
+   * Dfa for the single string
+   */
+  IntervalDfa MakeString(const std::string& str);
+};
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_INTERVALDFATEST_H_ */
@@ -0,0 +1,63 @@
+/*
+ * LazyIntersectionTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "LazyIntersectionTest.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+using namespace ::testing;
+
+void LazyIntersectionTest::SetUp() {
+}
+
+void LazyIntersectionTest::TearDown() {
+}
+
+TEST_F(LazyIntersectionTest, IsEmpty) {
+  auto letters = StringAutomaton::makeRegexAuto("[a-z]+");
+  auto digits = StringAutomaton::makeRegexAuto("[0-9]+");
+  auto short_strings = StringAutomaton::makeLengthLessThan(4);
+
+  LazyIntersection empty_intersection({letters, digits});
+  EXPECT_TRUE(empty_intersection.IsEmpty());
+
+  LazyIntersection intersection({letters, short_strings});
+  EXPECT_FALSE(intersection.IsEmpty());
+
+  auto phi = StringAutomaton::makePhi();
+  intersection.Add(phi);
+  EXPECT_TRUE(intersection.IsEmpty());
+
+  delete letters;
+  delete digits;
+  delete short_strings;
+  delete phi;
+}
+
+TEST_F(LazyIntersectionTest, Materialize) {
+  auto letters = StringAutomaton::makeRegexAuto("[a-z]+");
+  auto short_strings = StringAutomaton::makeLengthLessThan(4);
+  auto expected = StringAutomaton::makeRegexAuto("[a-z]{1,3}");
+
+  LazyIntersection intersection({letters, short_strings});
+  auto result = intersection.Materialize();
+  EXPECT_TRUE(result->IsEqual(expected));
+
+  delete letters;
+  delete short_strings;
+  delete expected;
+  delete result;
+}
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
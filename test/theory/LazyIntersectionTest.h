@@ -0,0 +1,33 @@
+/*
+ * LazyIntersectionTest.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_LAZYINTERSECTIONTEST_H_
+#define THEORY_LAZYINTERSECTIONTEST_H_
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "theory/LazyIntersection.h"
+#include "theory/StringAutomaton.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+class LazyIntersectionTest : public ::testing::Test {
+protected:
+  virtual void SetUp();
+  virtual void TearDown();
+};
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_LAZYINTERSECTIONTEST_H_ */
@@ -0,0 +1,114 @@
+/*
+ * RegexCompilerTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "RegexCompilerTest.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+using namespace ::testing;
+
+void RegexCompilerTest::SetUp() {
+}
+
+void RegexCompilerTest::TearDown() {
+}
+
+bool RegexCompilerTest::Accepts(const RegexCompiler& regex_compiler, const std::string& input) {
+  int state = 0;
+  for (char c : input) {
+    state = regex_compiler.next_state(state, static_cast<unsigned char>(c));
+  }
+  return regex_compiler.is_accepting(state);
+}
+
+TEST_F(RegexCompilerTest, IsSupported) {
+  Util::RegularExpression supported("(ab)*d+[a-z]?@");
+  EXPECT_TRUE(RegexCompiler::IsSupported(&supported));
+  Util::RegularExpression_ptr intersection = Util::RegularExpression::makeIntersection(
+      Util::RegularExpression::makeRepeatStar(Util::RegularExpression::makeChar('a')),
+      Util::RegularExpression::makeRepeatStar(Util::RegularExpression::makeChar('b')));
+  EXPECT_FALSE(RegexCompiler::IsSupported(intersection));
+  delete intersection;
+  Util::RegularExpression complement("~(ab)");
+  EXPECT_FALSE(RegexCompiler::IsSupported(&complement));
+}
+
+TEST_F(RegexCompilerTest, UnionConcatAndStar) {
+  Util::RegularExpression_ptr regex = Util::RegularExpression::makeConcatenation(
+      Util::RegularExpression::makeRepeatStar(
+          Util::RegularExpression::makeUnion(Util::RegularExpression::makeString("ab"),
+                                             Util::RegularExpression::makeChar('c'))),
+      Util::RegularExpression::makeChar('d'));
+  RegexCompiler regex_compiler(regex);
+  regex_compiler.Compile();
+  delete regex;
+  EXPECT_TRUE(Accepts(regex_compiler, "d"));
+  EXPECT_TRUE(Accepts(regex_compiler, "abcd"));
+  EXPECT_TRUE(Accepts(regex_compiler, "ccabd"));
+  EXPECT_FALSE(Accepts(regex_compiler, ""));
+  EXPECT_FALSE(Accepts(regex_compiler, "ad"));
+  EXPECT_FALSE(Accepts(regex_compiler, "abdd"));
+}
+
+TEST_F(RegexCompilerTest, CharRangeAndAnyChar) {
+  Util::RegularExpression regex("[a-c].");
+  RegexCompiler regex_compiler(&regex);
+  regex_compiler.Compile();
+  EXPECT_TRUE(Accepts(regex_compiler, "az"));
+  EXPECT_TRUE(Accepts(regex_compiler, "c\xff"));
+  EXPECT_FALSE(Accepts(regex_compiler, "dz"));
+  EXPECT_FALSE(Accepts(regex_compiler, "a"));
+}
+
+TEST_F(RegexCompilerTest, BoundedRepeat) {
+  Util::RegularExpression regex("(ab){2,3}");
+  RegexCompiler regex_compiler(&regex);
+  regex_compiler.Compile();
+  EXPECT_FALSE(Accepts(regex_compiler, "ab"));
+  EXPECT_TRUE(Accepts(regex_compiler, "abab"));
+  EXPECT_TRUE(Accepts(regex_compiler, "ababab"));
+  EXPECT_FALSE(Accepts(regex_compiler, "abba"));
+  EXPECT_FALSE(Accepts(regex_compiler, "abababab"));
+
+  Util::RegularExpression min_regex("(ab){2,}");
+  RegexCompiler min_regex_compiler(&min_regex);
+  min_regex_compiler.Compile();
+  EXPECT_FALSE(Accepts(min_regex_compiler, "ab"));
+  EXPECT_TRUE(Accepts(min_regex_compiler, "abab"));
+  EXPECT_TRUE(Accepts(min_regex_compiler, "abababab"));
+  EXPECT_FALSE(Accepts(min_regex_compiler, "ababa"));
+}
+
+TEST_F(RegexCompilerTest, OptionalAndPlus) {
+  Util::RegularExpression regex("a?b+");
+  RegexCompiler regex_compiler(&regex);
+  regex_compiler.Compile();
+  EXPECT_TRUE(Accepts(regex_compiler, "b"));
+  EXPECT_TRUE(Accepts(regex_compiler, "abbb"));
+  EXPECT_FALSE(Accepts(regex_compiler, "a"));
+  EXPECT_FALSE(Accepts(regex_compiler, "aab"));
+}
+
+TEST_F(RegexCompilerTest, SharesCharacterClasses) {
+  Util::RegularExpression regex("[a-z]*");
+  RegexCompiler regex_compiler(&regex);
+  regex_compiler.Compile();
+  // initial, loop and sink states, the range is handled as a single character class
+  EXPECT_EQ(3, regex_compiler.num_of_states());
+  EXPECT_TRUE(Accepts(regex_compiler, ""));
+  EXPECT_TRUE(Accepts(regex_compiler, "regex"));
+  EXPECT_FALSE(Accepts(regex_compiler, "Regex"));
+}
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
@@ -0,0 +1,40 @@
+/*
+ * RegexCompilerTest.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_REGEXCOMPILERTEST_H_
+#define THEORY_REGEXCOMPILERTEST_H_
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "theory/RegexCompiler.h"
+#include "utils/RegularExpression.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+class RegexCompilerTest : public ::testing::Test {
+protected:
+  virtual void SetUp();
+  virtual void TearDown();
+
+  /**
+   * Runs the compiled dfa on the input
+   */
+  bool Accepts(const RegexCompiler& regex_compiler, const std::string& input);
+};
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_REGEXCOMPILERTEST_H_ */
@@ -0,0 +1,151 @@
+/*
+ * StringAutomatonTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "StringAutomatonTest.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+using namespace ::testing;
+
+void StringAutomatonTest::SetUp() {
+}
+
+void StringAutomatonTest::TearDown() {
+}
+
+std::string StringAutomatonTest::ToString(const std::vector<std::vector<char>>& word) {
+  std::string result;
+  for (auto& symbol : word) {
+    unsigned char c = 0;
+    for (char bit : symbol) {
+      c = (c << 1) | (bit == '1' ? 1 : 0);
+    }
+    result.push_back(static_cast<char>(c));
+  }
+  return result;
+}
+
+TEST_F(StringAutomatonTest, IsEqual) {
+  auto regex_auto = StringAutomaton::makeRegexAuto("(ab)*");
+  auto same_auto = StringAutomaton::makeRegexAuto("((ab)|(abab))*");
+  auto other_auto = StringAutomaton::makeRegexAuto("(ab)*a");
+  std::vector<std::vector<char>> counter_example;
+
+  EXPECT_TRUE(regex_auto->IsEqual(same_auto));
+  EXPECT_TRUE(regex_auto->IsEqual(same_auto, counter_example));
+  EXPECT_FALSE(regex_auto->IsEqual(other_auto, counter_example));
+  EXPECT_EQ("", ToString(counter_example));
+
+  delete regex_auto;
+  delete same_auto;
+  delete other_auto;
+}
+
+TEST_F(StringAutomatonTest, IsSubsetOf) {
+  auto digits_auto = StringAutomaton::makeRegexAuto("[0-9]{2}");
+  auto alphanumeric_auto = StringAutomaton::makeRegexAuto("[0-9a-z]+");
+  std::vector<std::vector<char>> counter_example;
+
+  EXPECT_TRUE(digits_auto->IsSubsetOf(alphanumeric_auto));
+  EXPECT_FALSE(alphanumeric_auto->IsSubsetOf(digits_auto, counter_example));
+  EXPECT_EQ(1, counter_example.size());
+
+  delete digits_auto;
+  delete alphanumeric_auto;
+}
+
+TEST_F(StringAutomatonTest, Count) {
+  auto regex_auto = StringAutomaton::makeRegexAuto("(a|b)c*");
+  auto any_char_auto = StringAutomaton::makeAnyChar();
+
+  EXPECT_EQ(4, regex_auto->Count(2));
+  EXPECT_EQ(256, any_char_auto->Count(3));
+
+  delete regex_auto;
+  delete any_char_auto;
+}
+
+TEST_F(StringAutomatonTest, Concat) {
+  auto left_auto = StringAutomaton::makeRegexAuto("a");
+  auto right_auto = StringAutomaton::makeRegexAuto("b*c");
+  auto expected_auto = StringAutomaton::makeRegexAuto("ab*c");
+
+  auto concat_auto = left_auto->concat(right_auto);
+  EXPECT_TRUE(concat_auto->IsEqual(expected_auto));
+
+  auto pre_left_auto = concat_auto->preConcatLeft(right_auto);
+  EXPECT_TRUE(pre_left_auto->IsEqual(left_auto));
+  auto pre_right_auto = concat_auto->preConcatRight(left_auto);
+  EXPECT_TRUE(pre_right_auto->IsEqual(right_auto));
+
+  delete left_auto;
+  delete right_auto;
+  delete expected_auto;
+  delete concat_auto;
+  delete pre_left_auto;
+  delete pre_right_auto;
+}
+
+TEST_F(StringAutomatonTest, PreConcatRightWithNonMatchingPrefix) {
+  auto subject_auto = StringAutomaton::makeRegexAuto("ab*c");
+  auto prefix_auto = StringAutomaton::makeString("x");
+
+  auto suffix_auto = subject_auto->preConcatRight(prefix_auto);
+  EXPECT_TRUE(suffix_auto->isEmptyLanguage());
+  auto other_suffix_auto = subject_auto->preConcatRight(prefix_auto);
+  EXPECT_TRUE(other_suffix_auto->isEmptyLanguage());
+
+  delete subject_auto;
+  delete prefix_auto;
+  delete suffix_auto;
+  delete other_suffix_auto;
+}
+
+TEST_F(StringAutomatonTest, CloneSharesDfa) {
+  auto regex_auto = StringAutomaton::makeRegexAuto("abc");
+  auto cloned_auto = regex_auto->clone();
+  EXPECT_EQ(regex_auto->getDFA(), cloned_auto->getDFA());
+
+  auto prefix_auto = cloned_auto->prefixes();
+  EXPECT_NE(regex_auto->getDFA(), prefix_auto->getDFA());
+  EXPECT_FALSE(prefix_auto->IsEqual(regex_auto));
+
+  delete regex_auto;
+  EXPECT_EQ(1, cloned_auto->Count(3));
+
+  delete cloned_auto;
+  delete prefix_auto;
+}
+
+TEST_F(StringAutomatonTest, MutatingCloneKeepsCacheEntry) {
+  auto& automaton_cache = StringAutomatonCache::Instance();
+  auto cached_auto = StringAutomaton::makeRegexAuto("abcd");
+  auto cloned_auto = cached_auto->clone();
+  auto prefix_auto = cloned_auto->prefixes();
+  EXPECT_EQ(5, prefix_auto->Count(4));
+
+  auto num_of_hits = automaton_cache.num_of_hits();
+  auto cache_entry_auto = StringAutomaton::makeRegexAuto("abcd");
+  EXPECT_EQ(num_of_hits + 1, automaton_cache.num_of_hits());
+  EXPECT_EQ(1, cache_entry_auto->Count(4));
+  EXPECT_TRUE(cache_entry_auto->IsEqual(cached_auto));
+  EXPECT_EQ(1, cloned_auto->Count(4));
+
+  delete cached_auto;
+  delete cloned_auto;
+  delete prefix_auto;
+  delete cache_entry_auto;
+}
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
@@ -0,0 +1,40 @@
+/*
+ * StringAutomatonTest.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_STRINGAUTOMATONTEST_H_
+#define THEORY_STRINGAUTOMATONTEST_H_
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "theory/StringAutomaton.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+class StringAutomatonTest : public ::testing::Test {
+protected:
+  virtual void SetUp();
+  virtual void TearDown();
+
+  /**
+   * Decodes 8 bit symbols into a string
+   */
+  std::string ToString(const std::vector<std::vector<char>>& word);
+};
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_STRINGAUTOMATONTEST_H_ */
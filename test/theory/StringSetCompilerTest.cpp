@@ -0,0 +1,70 @@
+/*
+ * StringSetCompilerTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "StringSetCompilerTest.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+using namespace ::testing;
+
+void StringSetCompilerTest::SetUp() {
+}
+
+void StringSetCompilerTest::TearDown() {
+}
+
+bool StringSetCompilerTest::Accepts(const StringSetCompiler& string_set_compiler, const std::string& input) {
+  int state = 0;
+  for (char c : input) {
+    auto& transitions = string_set_compiler.get_transitions(state);
+    auto it = transitions.find(static_cast<unsigned char>(c));
+    if (it == transitions.end()) {
+      return false;
+    }
+    state = it->second;
+  }
+  return string_set_compiler.is_accepting(state);
+}
+
+TEST_F(StringSetCompilerTest, AcceptsExactlyTheStrings) {
+  StringSetCompiler string_set_compiler({"POST", "GET", "PUT", "", "GET", "\xff"});
+  string_set_compiler.Compile();
+  EXPECT_TRUE(Accepts(string_set_compiler, "GET"));
+  EXPECT_TRUE(Accepts(string_set_compiler, "POST"));
+  EXPECT_TRUE(Accepts(string_set_compiler, "PUT"));
+  EXPECT_TRUE(Accepts(string_set_compiler, ""));
+  EXPECT_TRUE(Accepts(string_set_compiler, "\xff"));
+  EXPECT_FALSE(Accepts(string_set_compiler, "GE"));
+  EXPECT_FALSE(Accepts(string_set_compiler, "GETS"));
+  EXPECT_FALSE(Accepts(string_set_compiler, "PU"));
+  EXPECT_FALSE(Accepts(string_set_compiler, "HEAD"));
+}
+
+TEST_F(StringSetCompilerTest, SharesSuffixes) {
+  StringSetCompiler string_set_compiler({"tap", "taps", "top", "tops"});
+  string_set_compiler.Compile();
+  // t, {a, o}, p, s, final
+  EXPECT_EQ(5, string_set_compiler.num_of_states());
+  EXPECT_TRUE(Accepts(string_set_compiler, "tops"));
+  EXPECT_FALSE(Accepts(string_set_compiler, "tos"));
+}
+
+TEST_F(StringSetCompilerTest, Empty) {
+  StringSetCompiler string_set_compiler({});
+  string_set_compiler.Compile();
+  EXPECT_EQ(1, string_set_compiler.num_of_states());
+  EXPECT_FALSE(Accepts(string_set_compiler, ""));
+}
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
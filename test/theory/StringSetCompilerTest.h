@@ -0,0 +1,39 @@
+/*
+ * StringSetCompilerTest.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_STRINGSETCOMPILERTEST_H_
+#define THEORY_STRINGSETCOMPILERTEST_H_
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "theory/StringSetCompiler.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+class StringSetCompilerTest : public ::testing::Test {
+protected:
+  virtual void SetUp();
+  virtual void TearDown();
+
+  /**
+   * Runs the compiled dfa on the input
+   */
+  bool Accepts(const StringSetCompiler& string_set_compiler, const std::string& input);
+};
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_STRINGSETCOMPILERTEST_H_ */
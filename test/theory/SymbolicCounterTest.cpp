@@ -0,0 +1,115 @@
+/*
+ * SymbolicCounterTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "SymbolicCounterTest.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+using namespace ::testing;
+
+static SymbolicCounter MakeCounter(const Eigen::SparseMatrix<BigInteger>& matrix, SymbolicCounter::Type type) {
+  SymbolicCounter counter;
+  counter.set_type(type);
+  counter.set_transition_count_matrix(matrix);
+  counter.set_initialization_vector(matrix.innerVector(matrix.cols() - 1));
+  return counter;
+}
+
+void SymbolicCounterTest::SetUp() {
+  std::vector<Eigen::Triplet<BigInteger>> entries {{0, 0, 2}, {0, 1, 1}, {1, 1, 1}};
+  binary_alphabet_matrix_.resize(2, 2);
+  binary_alphabet_matrix_.setFromTriplets(entries.begin(), entries.end());
+  binary_alphabet_matrix_.makeCompressed();
+}
+
+void SymbolicCounterTest::TearDown() {
+}
+
+TEST_F(SymbolicCounterTest, Count) {
+  auto counter = MakeCounter(binary_alphabet_matrix_, SymbolicCounter::Type::STRING);
+  EXPECT_EQ(BigInteger(1), counter.Count(0));
+  EXPECT_EQ(BigInteger(3), counter.Count(1));
+  EXPECT_EQ(BigInteger(31), counter.Count(4));
+  // large gap and smaller bound after a larger one
+  EXPECT_EQ((BigInteger(1) << 101) - 1, counter.Count(100));
+  EXPECT_EQ(BigInteger(15), counter.Count(3));
+}
+
+TEST_F(SymbolicCounterTest, CountbyMatrixMultiplication) {
+  auto counter = MakeCounter(binary_alphabet_matrix_, SymbolicCounter::Type::STRING);
+  for (unsigned long bound : {0, 1, 2, 7, 64, 5, 1000}) {
+    EXPECT_EQ((BigInteger(1) << (bound + 1)) - 1, counter.CountbyMatrixMultiplication(bound));
+  }
+}
+
+TEST_F(SymbolicCounterTest, CountOverflowsFixedWidth) {
+  // all strings over 256 characters, counts exceed 128 bits after 16 characters
+  std::vector<Eigen::Triplet<BigInteger>> entries {{0, 0, 256}, {0, 1, 1}, {1, 1, 1}};
+  Eigen::SparseMatrix<BigInteger> any_string_matrix(2, 2);
+  any_string_matrix.setFromTriplets(entries.begin(), entries.end());
+  any_string_matrix.makeCompressed();
+
+  auto counter = MakeCounter(any_string_matrix, SymbolicCounter::Type::STRING);
+  for (unsigned long bound = 0; bound <= 40; ++bound) {
+    EXPECT_EQ((boost::multiprecision::pow(BigInteger(256), bound + 1) - 1) / 255, counter.Count(bound));
+  }
+}
+
+TEST_F(SymbolicCounterTest, CountMultipleBounds) {
+  auto counter = MakeCounter(binary_alphabet_matrix_, SymbolicCounter::Type::STRING);
+  counter.Count(50);
+  std::vector<unsigned long> bounds {16, 4, 8, 200, 4};
+  auto counts = counter.Count(bounds);
+  ASSERT_EQ(bounds.size(), counts.size());
+  for (std::size_t i = 0; i < bounds.size(); ++i) {
+    EXPECT_EQ((BigInteger(1) << (bounds[i] + 1)) - 1, counts[i]);
+  }
+}
+
+TEST_F(SymbolicCounterTest, CountUnaryInt) {
+  auto counter = MakeCounter(binary_alphabet_matrix_, SymbolicCounter::Type::UNARYINT);
+  // unary int counting takes 2^bound - 1 transitions
+  EXPECT_EQ((BigInteger(1) << 16) - 1, counter.Count(4));
+  EXPECT_EQ((BigInteger(1) << 8) - 1, counter.Count(3));
+  EXPECT_EQ(counter.Count(10), counter.CountbyMatrixMultiplication(10));
+}
+
+TEST_F(SymbolicCounterTest, CountbyRecurrence) {
+  // strings over {a, b} without "aa": state 0 last char is not 'a', state 1 last char is 'a'
+  std::vector<Eigen::Triplet<BigInteger>> entries {{0, 0, 1}, {0, 1, 1}, {1, 0, 1}, {0, 2, 1}, {1, 2, 1}, {2, 2, 1}};
+  Eigen::SparseMatrix<BigInteger> no_aa_matrix(3, 3);
+  no_aa_matrix.setFromTriplets(entries.begin(), entries.end());
+  no_aa_matrix.makeCompressed();
+
+  auto counter = MakeCounter(no_aa_matrix, SymbolicCounter::Type::STRING);
+  auto expected = MakeCounter(no_aa_matrix, SymbolicCounter::Type::STRING);
+  for (unsigned long bound : {0, 1, 2, 3, 5, 6, 10, 50, 300}) {
+    EXPECT_EQ(expected.Count(bound), counter.CountbyRecurrence(bound));
+  }
+
+  // finite language {"ab"}, nilpotent count matrix
+  entries = {{0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {3, 3, 1}};
+  Eigen::SparseMatrix<BigInteger> ab_matrix(4, 4);
+  ab_matrix.setFromTriplets(entries.begin(), entries.end());
+  ab_matrix.makeCompressed();
+  auto ab_counter = MakeCounter(ab_matrix, SymbolicCounter::Type::STRING);
+  EXPECT_EQ(BigInteger(0), ab_counter.CountbyRecurrence(1));
+  EXPECT_EQ(BigInteger(1), ab_counter.CountbyRecurrence(2));
+  EXPECT_EQ(BigInteger(1), ab_counter.CountbyRecurrence(1000));
+
+  auto binary_counter = MakeCounter(binary_alphabet_matrix_, SymbolicCounter::Type::STRING);
+  EXPECT_EQ((BigInteger(1) << 4097) - 1, binary_counter.CountbyRecurrence(4096));
+}
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
@@ -0,0 +1,38 @@
+/*
+ * SymbolicCounterTest.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_SYMBOLICCOUNTERTEST_H_
+#define THEORY_SYMBOLICCOUNTERTEST_H_
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "theory/SymbolicCounter.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+class SymbolicCounterTest : public ::testing::Test {
+protected:
+  virtual void SetUp();
+  virtual void TearDown();
+
+  /**
+   * Count matrix of the automaton accepting all words over a 2 letter alphabet,
+   * state 0 is the only (accepting) state, state 1 is the artificial accepting state
+   */
+  Eigen::SparseMatrix<BigInteger> binary_alphabet_matrix_;
+};
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_SYMBOLICCOUNTERTEST_H_ */
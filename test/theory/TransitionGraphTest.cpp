@@ -0,0 +1,86 @@
+/*
+ * TransitionGraphTest.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "TransitionGraphTest.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+using namespace ::testing;
+
+void TransitionGraphTest::SetUp() {
+}
+
+void TransitionGraphTest::TearDown() {
+}
+
+TransitionGraph TransitionGraphTest::MakeGraph(const std::vector<std::vector<int>>& successors) {
+  TransitionGraph transition_graph;
+  for (auto& next_nodes : successors) {
+    transition_graph.AddNode();
+    for (int next_node : next_nodes) {
+      transition_graph.AddEdge(next_node, 1);
+    }
+  }
+  return transition_graph;
+}
+
+TEST_F(TransitionGraphTest, Reachability) {
+  // 0 -> 1 -> 2 -> 1, 3 is isolated
+  auto transition_graph = MakeGraph({{1}, {2}, {1}, {}});
+  EXPECT_EQ(4, transition_graph.num_of_nodes());
+  EXPECT_EQ(3, transition_graph.num_of_edges());
+  EXPECT_TRUE(transition_graph.IsReachable(0, 2));
+  EXPECT_TRUE(transition_graph.IsReachable(1, 1));
+  EXPECT_FALSE(transition_graph.IsReachable(0, 0));
+  EXPECT_FALSE(transition_graph.IsReachable(0, 3));
+  EXPECT_EQ(std::vector<int>({1, 2}), transition_graph.GetNodesReachableBy(0, 1, 5));
+  EXPECT_EQ(std::vector<int>({2}), transition_graph.GetNodesReachableBy(0, 2, 2));
+  EXPECT_EQ(std::vector<int>({0}), transition_graph.GetNodesReachableBy(0, 0, 0));
+}
+
+TEST_F(TransitionGraphTest, Cycles) {
+  EXPECT_TRUE(MakeGraph({{1}, {2}, {1}}).HasCycle(0));
+  EXPECT_FALSE(MakeGraph({{1, 2}, {2}, {}}).HasCycle(0));
+  EXPECT_TRUE(MakeGraph({{0}}).HasCycle(0));
+
+  auto cyclic_nodes = MakeGraph({{1, 3}, {2}, {1}, {3}, {0}}).FindCyclicNodes(0);
+  EXPECT_EQ(std::vector<bool>({false, true, true, true, false}), cyclic_nodes);
+}
+
+TEST_F(TransitionGraphTest, FindSCCs) {
+  // sccs {0, 1}, {2, 3}, {4}
+  auto scc_ids = MakeGraph({{1}, {0, 2}, {3}, {2, 4}, {}}).FindSCCs(0);
+  EXPECT_EQ(scc_ids[0], scc_ids[1]);
+  EXPECT_EQ(scc_ids[2], scc_ids[3]);
+  EXPECT_NE(scc_ids[0], scc_ids[2]);
+  EXPECT_NE(scc_ids[2], scc_ids[4]);
+  // reverse topological order
+  EXPECT_LT(scc_ids[4], scc_ids[2]);
+  EXPECT_LT(scc_ids[2], scc_ids[0]);
+}
+
+TEST_F(TransitionGraphTest, LongChain) {
+  const int num_of_nodes = 200000;
+  std::vector<std::vector<int>> successors(num_of_nodes);
+  for (int i = 0; i + 1 < num_of_nodes; ++i) {
+    successors[i].push_back(i + 1);
+  }
+  successors.back().push_back(0);
+  auto transition_graph = MakeGraph(successors);
+  EXPECT_TRUE(transition_graph.HasCycle(0));
+  auto scc_ids = transition_graph.FindSCCs(0);
+  EXPECT_EQ(scc_ids.front(), scc_ids.back());
+}
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
@@ -0,0 +1,40 @@
+/*
+ * TransitionGraphTest.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved. 
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_TRANSITIONGRAPHTEST_H_
+#define THEORY_TRANSITIONGRAPHTEST_H_
+
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "theory/TransitionGraph.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+class TransitionGraphTest : public ::testing::Test {
+protected:
+  virtual void SetUp();
+  virtual void TearDown();
+
+  /**
+   * Graph with the given successor lists, every edge has multiplicity 1
+   */
+  TransitionGraph MakeGraph(const std::vector<std::vector<int>>& successors);
+};
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_TRANSITIONGRAPHTEST_H_ */